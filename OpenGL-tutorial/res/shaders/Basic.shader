@@ -6,7 +6,14 @@ layout(location = 1) in vec4 a_Color;
 layout(location = 2) in vec2 a_TexCoord;
 layout(location = 3) in float a_TexIndex;
 
-uniform mat4 u_MVP;  // Model View Projection Matrix
+layout(std140) uniform Camera  // UniformBinding::Camera, CameraUniforms on the C++ side
+{
+	mat4 u_View;
+	mat4 u_Projection;
+	mat4 u_ViewProjection;
+};
+
+uniform mat4 u_Model;
 
 out vec4 v_Color;
 out vec2 v_TexCoord;
@@ -17,7 +24,7 @@ void main()
 	v_Color = a_Color;
 	v_TexCoord = a_TexCoord;
 	v_TexIndex = a_TexIndex;
-	gl_Position = u_MVP * a_Position;
+	gl_Position = u_ViewProjection * u_Model * a_Position;
 };
 
 #shader fragment
@@ -3,11 +3,18 @@
 
 layout(location = 0) in vec4 position;
 
-uniform mat4 u_MVP;  // Model View Projection Matrix
+layout(std140) uniform Camera  // UniformBinding::Camera, CameraUniforms on the C++ side
+{
+	mat4 u_View;
+	mat4 u_Projection;
+	mat4 u_ViewProjection;
+};
+
+uniform mat4 u_Model;
 
 void main()
 {
-	gl_Position = u_MVP * position;
+	gl_Position = u_ViewProjection * u_Model * position;
 };
 
 #shader fragment
@@ -0,0 +1,58 @@
+#shader compute
+#version 430 core
+
+// One invocation per sprite instance. Visible instances are appended to the output
+// buffer and counted in the instanceCount of the indirect draw command.
+
+layout(local_size_x = 256) in;
+
+// Instances are read as raw words: x y width height rotation u0 v0 u1 v1 rgba8,
+// the layout of test::SpriteInstance
+#define INSTANCE_WORDS 10
+
+layout(std430, binding = 0) readonly buffer InputInstances
+{
+	uint inputWords[];
+};
+
+layout(std430, binding = 1) writeonly buffer VisibleInstances
+{
+	uint outputWords[];
+};
+
+layout(std430, binding = 2) buffer DrawCommand
+{
+	uint count;
+	uint instanceCount;
+	uint firstIndex;
+	int baseVertex;
+	uint baseInstance;
+};
+
+uniform mat4 u_ViewProjection;
+uniform int u_InstanceCount;
+
+void main()
+{
+	uint index = gl_GlobalInvocationID.x;
+	if (index >= uint(u_InstanceCount))
+		return;
+
+	uint base = index * INSTANCE_WORDS;
+	vec2 center = vec2(uintBitsToFloat(inputWords[base + 0]), uintBitsToFloat(inputWords[base + 1]));
+	vec2 size = vec2(uintBitsToFloat(inputWords[base + 2]), uintBitsToFloat(inputWords[base + 3]));
+
+	// Bounding circle of the rotated sprite, its extent projected on both clip axes
+	float radius = 0.5 * length(size);
+	vec4 clip = u_ViewProjection * vec4(center, 0.0, 1.0);
+	vec2 extent = radius * vec2(abs(u_ViewProjection[0][0]) + abs(u_ViewProjection[1][0]),
+	                            abs(u_ViewProjection[0][1]) + abs(u_ViewProjection[1][1]));
+
+	if (any(greaterThan(abs(clip.xy) - extent, vec2(clip.w))))
+		return;
+
+	uint slot = atomicAdd(instanceCount, 1u);
+	uint outBase = slot * INSTANCE_WORDS;
+	for (uint i = 0u; i < INSTANCE_WORDS; ++i)
+		outputWords[outBase + i] = inputWords[base + i];
+}
@@ -0,0 +1,49 @@
+#shader vertex
+#version 330 core
+
+// Per vertex: a unit quad from (0, 0) to (1, 1)
+layout(location = 0) in vec2 a_Position;
+
+// Per instance
+layout(location = 1) in vec2 i_Position;  // center of the sprite
+layout(location = 2) in vec2 i_Size;
+layout(location = 3) in float i_Rotation;  // radians
+layout(location = 4) in vec4 i_UVRect;  // u0 v0 u1 v1
+layout(location = 5) in vec4 i_Color;
+
+layout(std140) uniform Camera  // UniformBinding::Camera, CameraUniforms on the C++ side
+{
+	mat4 u_View;
+	mat4 u_Projection;
+	mat4 u_ViewProjection;
+};
+
+out vec2 v_TexCoord;
+out vec4 v_Color;
+
+void main()
+{
+	vec2 local = (a_Position - 0.5) * i_Size;
+	float c = cos(i_Rotation);
+	float s = sin(i_Rotation);
+	vec2 world = i_Position + vec2(c * local.x - s * local.y, s * local.x + c * local.y);
+
+	v_TexCoord = mix(i_UVRect.xy, i_UVRect.zw, a_Position);
+	v_Color = i_Color;
+	gl_Position = u_ViewProjection * vec4(world, 0.0, 1.0);
+};
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+in vec4 v_Color;
+
+uniform sampler2D u_Texture;
+
+void main()
+{
+	color = texture(u_Texture, v_TexCoord) * v_Color;
+};
@@ -0,0 +1,39 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec4 a_Position;
+layout(location = 1) in vec4 a_Normal;  // GL_INT_2_10_10_10_REV, normalized
+
+layout(std140) uniform Camera  // UniformBinding::Camera, CameraUniforms on the C++ side
+{
+	mat4 u_View;
+	mat4 u_Projection;
+	mat4 u_ViewProjection;
+};
+
+uniform mat4 u_Model;
+
+out vec3 v_Normal;
+
+void main()
+{
+	v_Normal = a_Normal.xyz;
+	gl_Position = u_ViewProjection * u_Model * a_Position;
+};
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 o_Color;
+
+in vec3 v_Normal;
+
+uniform vec4 u_Color;
+
+void main()
+{
+	// One directional light from the top left, enough to show the packed normals
+	vec3 light = normalize(vec3(-0.5, 0.5, 1.0));
+	float diffuse = max(dot(normalize(v_Normal), light), 0.0);
+	o_Color = vec4(u_Color.rgb * (0.25 + 0.75 * diffuse), u_Color.a);
+};
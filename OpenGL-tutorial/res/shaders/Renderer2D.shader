@@ -0,0 +1,55 @@
+#shader vertex
+#version 450 core
+
+layout(location = 0) in vec4 a_Position;
+layout(location = 1) in vec4 a_Color;
+layout(location = 2) in vec2 a_TexCoord;
+#ifdef PACKED_VERTICES
+layout(location = 3) in uint a_TexIndex;  // 8-bit integer attribute
+#else
+layout(location = 3) in float a_TexIndex;
+#endif
+
+layout(std140) uniform Camera  // UniformBinding::Camera, CameraUniforms on the C++ side
+{
+	mat4 u_View;
+	mat4 u_Projection;
+	mat4 u_ViewProjection;
+};
+
+out vec4 v_Color;
+out vec2 v_TexCoord;
+flat out int v_TexIndex;
+
+void main()
+{
+	v_Color = a_Color;
+	v_TexCoord = a_TexCoord;
+	v_TexIndex = int(a_TexIndex);
+	gl_Position = u_ViewProjection * a_Position;
+};
+
+#shader fragment
+#version 450 core
+
+layout(location = 0) out vec4 o_Color;
+
+in vec4 v_Color;
+in vec2 v_TexCoord;
+flat in int v_TexIndex;
+
+uniform sampler2D u_Textures[MAX_TEXTURE_SLOTS];  // defined by Renderer2D from the driver limit, slot 0 is white
+uniform int u_SDFSlots;  // bit i set: u_Textures[i] stores a signed distance field in alpha
+
+void main()
+{
+	vec4 texel = texture(u_Textures[v_TexIndex], v_TexCoord);
+	if (((u_SDFSlots >> v_TexIndex) & 1) != 0)
+	{
+		// Edge at 0.5, antialiased over about one screen pixel whatever the scale
+		float distance = texel.a;
+		float width = fwidth(distance);
+		texel.a = smoothstep(0.5 - width, 0.5 + width, distance);
+	}
+	o_Color = texel * v_Color;
+};
@@ -0,0 +1,74 @@
+#shader vertex
+#version 450 core
+
+layout(location = 0) in vec4 a_Position;
+layout(location = 1) in vec2 a_Local;
+layout(location = 2) in vec4 a_Params;
+layout(location = 3) in vec4 a_Color;
+layout(location = 4) in uint a_Shape;
+
+layout(std140) uniform Camera  // UniformBinding::Camera, CameraUniforms on the C++ side
+{
+	mat4 u_View;
+	mat4 u_Projection;
+	mat4 u_ViewProjection;
+};
+
+out vec2 v_Local;
+flat out vec4 v_Params;
+out vec4 v_Color;
+flat out uint v_Shape;
+
+void main()
+{
+	v_Local = a_Local;
+	v_Params = a_Params;
+	v_Color = a_Color;
+	v_Shape = a_Shape;
+	gl_Position = u_ViewProjection * a_Position;
+};
+
+#shader fragment
+#version 450 core
+
+layout(location = 0) out vec4 o_Color;
+
+in vec2 v_Local;
+flat in vec4 v_Params;
+in vec4 v_Color;
+flat in uint v_Shape;
+
+// Signed distances in world units, negative inside. Shape ids match Renderer2D::Shape.
+float Circle(vec2 p, float radius)
+{
+	return length(p) - radius;
+}
+
+float Ring(vec2 p, float radius, float halfThickness)
+{
+	return abs(length(p) - radius) - halfThickness;
+}
+
+float RoundedRect(vec2 p, vec2 halfSize, float radius)
+{
+	vec2 q = abs(p) - halfSize + radius;
+	return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - radius;
+}
+
+void main()
+{
+	float distance;
+	if (v_Shape == 0u)
+		distance = Circle(v_Local, v_Params.x);
+	else if (v_Shape == 1u)
+		distance = Ring(v_Local, v_Params.x, v_Params.y);
+	else
+		distance = RoundedRect(v_Local, v_Params.xy, v_Params.z);
+
+	// Coverage over about one screen pixel, whatever the zoom
+	float width = max(fwidth(distance), 1e-4);
+	float coverage = clamp(0.5 - distance / width, 0.0, 1.0);
+	if (coverage <= 0.0)
+		discard;
+	o_Color = vec4(v_Color.rgb, v_Color.a * coverage);
+};
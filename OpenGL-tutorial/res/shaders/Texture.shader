@@ -6,11 +6,18 @@ layout(location = 1) in vec2 texCoord;
 
 out vec2 v_TexCoord;
 
-uniform mat4 u_MVP;  // Model View Projection Matrix
+layout(std140) uniform Camera  // UniformBinding::Camera, CameraUniforms on the C++ side
+{
+	mat4 u_View;
+	mat4 u_Projection;
+	mat4 u_ViewProjection;
+};
+
+uniform mat4 u_Model;
 
 void main()
 {
-	gl_Position = u_MVP * position;
+	gl_Position = u_ViewProjection * u_Model * position;
 	v_TexCoord = texCoord;
 };
 
@@ -7,6 +7,7 @@
 #include <sstream>
 
 #include "Renderer.h"
+#include "MeshOptimizer.h"
 
 #include "glm/glm.hpp"
 #include "glm/gtc/matrix_transform.hpp"
@@ -22,9 +23,28 @@
 #include "tests/TestBatchRenderingColors.h"
 #include "tests/TestBatchRenderingTexture2D.h"
 #include "tests/TestDynamicBatchRendering.h"
-
-int main(void)
+#include "tests/TestRenderer2D.h"
+#include "tests/TestRenderQueue.h"
+#include "tests/TestInstancedRendering.h"
+#include "tests/TestMeshOptimizer.h"
+#include "tests/TestText.h"
+#include "tests/TestParticles.h"
+#include "tests/TestShapes.h"
+#include "tests/TestTilemap.h"
+#include "tests/TestCommandBuffers.h"
+
+int main(int argc, char** argv)
 {
+	// Offline step, no window: OpenGL-tutorial --optimize-mesh in.mesh out.mesh
+	if (argc == 4 && std::string(argv[1]) == "--optimize-mesh")
+	{
+		MeshOptimizationStats stats;
+		if (!OptimizeMeshFile(argv[2], argv[3], &stats))
+			return -1;
+		std::cout << "ACMR " << stats.ACMRBefore << " -> " << stats.ACMRAfter << ", " << stats.VertexCount << " vertices\n";
+		return 0;
+	}
+
 	GLFWwindow* window;
 
 	/* Initialize the library */
@@ -56,8 +76,10 @@ int main(void)
 	std::cout << glGetString(GL_VERSION) << '\n';
 
 	{
-		GLCall(glEnable(GL_BLEND));
-		GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+		Renderer::Init();
+
+		GLStateCache::SetBlendEnabled(true);
+		GLStateCache::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 		Renderer renderer;
 
@@ -84,12 +106,30 @@ int main(void)
 		testMenu->RegisterTest<test::TestBatchRenderingColors>("Batch Rendering Colors");
 		testMenu->RegisterTest<test::TestBatchRenderingTexture2D>("Batch Rendering 2D Texture");
 		testMenu->RegisterTest<test::TestDynamicBatchRendering>("Dynamic Batching");
+		testMenu->RegisterTest<test::TestRenderer2D>("Renderer2D");
+		testMenu->RegisterTest<test::TestRenderQueue>("Render Queue");
+		testMenu->RegisterTest<test::TestInstancedRendering>("Instanced Rendering");
+		testMenu->RegisterTest<test::TestMeshOptimizer>("Mesh Optimizer");
+		testMenu->RegisterTest<test::TestText>("Text");
+		testMenu->RegisterTest<test::TestParticles>("Particles");
+		testMenu->RegisterTest<test::TestShapes>("SDF Shapes");
+		testMenu->RegisterTest<test::TestTilemap>("Tilemap");
+		testMenu->RegisterTest<test::TestCommandBuffers>("Command Buffers");
+
+		double lastTime = glfwGetTime();
 
 		/* Loop until the user closes the window */
 		while (!glfwWindowShouldClose(window))
 		{
+			double time = glfwGetTime();
+			float deltaTime = (float)(time - lastTime);  // seconds since the previous frame
+			lastTime = time;
+
+			GLStateCache::ResetStats();
+			Shader::ResetTotalUniformStats();
+
 			/* Render here */
-			GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+			GLStateCache::SetClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 			renderer.Clear();
 
 			// Start the Dear ImGui frame
@@ -99,7 +139,7 @@ int main(void)
 
 			if (currentTest)
 			{
-				currentTest->OnUpdate(0.0f);
+				currentTest->OnUpdate(deltaTime);
 				currentTest->OnRender();
 				ImGui::Begin("Test");
 				if (currentTest != testMenu && ImGui::Button("<-"))
@@ -108,12 +148,19 @@ int main(void)
 					currentTest = testMenu;
 				}
 				currentTest->OnImGuiRender();
+
+				const GLStateStats& glStats = GLStateCache::GetStats();
+				ImGui::Separator();
+				ImGui::Text("GL state calls: %u issued, %u skipped", glStats.IssuedCalls, glStats.SkippedCalls);
+				const UniformStats& uniformStats = Shader::GetTotalUniformStats();
+				ImGui::Text("Uniform uploads: %u, elided: %u", uniformStats.Uploads, uniformStats.ElidedUploads);
 				ImGui::End();
 			}
 
 			// Rendering
 			ImGui::Render();
 			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+			GLStateCache::Invalidate();  // the backend binds its own program, buffers and texture
 
 			/* Swap front and back buffers */
 			glfwSwapBuffers(window);
@@ -127,6 +174,8 @@ int main(void)
 		{
 			delete testMenu;
 		}
+
+		Renderer::Shutdown();
 	}
 
 	// Cleanup
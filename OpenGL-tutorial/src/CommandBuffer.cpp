@@ -0,0 +1,269 @@
+#include "CommandBuffer.h"
+
+#include "Renderer.h"
+#include "Texture.h"
+
+#include <cstring>
+#include <new>
+
+// Payloads, stored right after their header on 8-byte boundaries
+struct BindObjectCommand
+{
+	const void* Object;
+};
+
+struct BindTextureCommand
+{
+	const Texture* Object;
+	unsigned int Unit;
+};
+
+struct SetBlendCommand
+{
+	unsigned int Enabled;
+	unsigned int Source;
+	unsigned int Destination;
+};
+
+// Recorded by name or by handle, ID is ignored for the latter
+struct UniformTarget
+{
+	UniformID ID;
+	UniformHandle Handle;
+	bool ByHandle;
+
+	UniformTarget(UniformID id)
+		: ID(id), ByHandle(false)
+	{
+	}
+
+	UniformTarget(UniformHandle handle)
+		: ID(""), Handle(handle), ByHandle(true)
+	{
+	}
+
+	inline UniformHandle Resolve(const Shader& shader) const { return ByHandle ? Handle : shader.GetUniformHandle(ID); }
+};
+
+struct SetUniform1iCommand
+{
+	UniformTarget Target;
+	int Value;
+};
+
+struct SetUniform4fCommand
+{
+	UniformTarget Target;
+	float Value[4];
+};
+
+struct SetUniformMat4fCommand
+{
+	UniformTarget Target;
+	glm::mat4 Value;
+};
+
+struct UpdateBufferCommand
+{
+	VertexBuffer* Buffer;
+	unsigned int Offset;
+	unsigned int Size;  // bytes of data following this struct
+};
+
+struct DrawIndexedCommand
+{
+	unsigned int IndexCount;
+	int BaseVertex;
+};
+
+static unsigned int AlignSize(unsigned int size)
+{
+	return (size + 7) & ~7u;
+}
+
+CommandBuffer::CommandBuffer(unsigned int reservedBytes)
+	: m_CommandCount(0)
+{
+	static_assert(sizeof(CommandHeader) == 8, "payloads must stay 8-byte aligned");
+	m_Data.reserve(reservedBytes);
+}
+
+void CommandBuffer::Reset()
+{
+	m_Data.clear();
+	m_CommandCount = 0;
+}
+
+void* CommandBuffer::Allocate(CommandType type, unsigned int size)
+{
+	CommandHeader header = { type, AlignSize(size) };
+
+	const size_t offset = m_Data.size();
+	m_Data.resize(offset + sizeof(CommandHeader) + header.Size);
+	memcpy(&m_Data[offset], &header, sizeof(header));
+	m_CommandCount++;
+	return &m_Data[offset + sizeof(CommandHeader)];
+}
+
+void CommandBuffer::BindShader(Shader& shader)
+{
+	new (Allocate(CommandType::BindShader, sizeof(BindObjectCommand))) BindObjectCommand{ &shader };
+}
+
+void CommandBuffer::BindVertexArray(const VertexArray& va)
+{
+	new (Allocate(CommandType::BindVertexArray, sizeof(BindObjectCommand))) BindObjectCommand{ &va };
+}
+
+void CommandBuffer::BindIndexBuffer(const IndexBuffer& ib)
+{
+	new (Allocate(CommandType::BindIndexBuffer, sizeof(BindObjectCommand))) BindObjectCommand{ &ib };
+}
+
+void CommandBuffer::BindTexture(const Texture& texture, unsigned int unit)
+{
+	new (Allocate(CommandType::BindTexture, sizeof(BindTextureCommand))) BindTextureCommand{ &texture, unit };
+}
+
+void CommandBuffer::SetBlend(bool enabled, unsigned int source, unsigned int destination)
+{
+	new (Allocate(CommandType::SetBlend, sizeof(SetBlendCommand))) SetBlendCommand{ enabled ? 1u : 0u, source, destination };
+}
+
+void CommandBuffer::SetUniform1i(UniformID id, int value)
+{
+	new (Allocate(CommandType::SetUniform1i, sizeof(SetUniform1iCommand))) SetUniform1iCommand{ id, value };
+}
+
+void CommandBuffer::SetUniform4f(UniformID id, float v0, float v1, float v2, float v3)
+{
+	new (Allocate(CommandType::SetUniform4f, sizeof(SetUniform4fCommand))) SetUniform4fCommand{ id, { v0, v1, v2, v3 } };
+}
+
+void CommandBuffer::SetUniformMat4f(UniformID id, const glm::mat4& matrix)
+{
+	new (Allocate(CommandType::SetUniformMat4f, sizeof(SetUniformMat4fCommand))) SetUniformMat4fCommand{ id, matrix };
+}
+
+void CommandBuffer::SetUniform1i(UniformHandle handle, int value)
+{
+	new (Allocate(CommandType::SetUniform1i, sizeof(SetUniform1iCommand))) SetUniform1iCommand{ handle, value };
+}
+
+void CommandBuffer::SetUniform4f(UniformHandle handle, float v0, float v1, float v2, float v3)
+{
+	new (Allocate(CommandType::SetUniform4f, sizeof(SetUniform4fCommand))) SetUniform4fCommand{ handle, { v0, v1, v2, v3 } };
+}
+
+void CommandBuffer::SetUniformMat4f(UniformHandle handle, const glm::mat4& matrix)
+{
+	new (Allocate(CommandType::SetUniformMat4f, sizeof(SetUniformMat4fCommand))) SetUniformMat4fCommand{ handle, matrix };
+}
+
+void CommandBuffer::UpdateBuffer(VertexBuffer& vb, const void* data, unsigned int size, unsigned int offset)
+{
+	unsigned char* payload = (unsigned char*)Allocate(CommandType::UpdateBuffer, sizeof(UpdateBufferCommand) + size);
+	new (payload) UpdateBufferCommand{ &vb, offset, size };
+	memcpy(payload + sizeof(UpdateBufferCommand), data, size);
+}
+
+void CommandBuffer::DrawIndexed(unsigned int indexCount, int baseVertex)
+{
+	new (Allocate(CommandType::DrawIndexed, sizeof(DrawIndexedCommand))) DrawIndexedCommand{ indexCount, baseVertex };
+}
+
+void CommandBuffer::Execute() const
+{
+	Shader* shader = nullptr;
+	const IndexBuffer* indexBuffer = nullptr;
+
+	// The binds go through the state cache, a stream that repeats the previous one's state costs nothing
+	const unsigned char* ptr = m_Data.data();
+	const unsigned char* end = ptr + m_Data.size();
+	while (ptr < end)
+	{
+		CommandHeader header;
+		memcpy(&header, ptr, sizeof(header));
+		const void* payload = ptr + sizeof(CommandHeader);
+		ptr += sizeof(CommandHeader) + header.Size;
+
+		switch (header.Type)
+		{
+		case CommandType::BindShader:
+			shader = (Shader*)((const BindObjectCommand*)payload)->Object;
+			shader->Bind();
+			break;
+
+		case CommandType::BindVertexArray:
+			((const VertexArray*)((const BindObjectCommand*)payload)->Object)->Bind();
+			break;
+
+		case CommandType::BindIndexBuffer:
+			indexBuffer = (const IndexBuffer*)((const BindObjectCommand*)payload)->Object;
+			indexBuffer->Bind();
+			break;
+
+		case CommandType::BindTexture:
+		{
+			const BindTextureCommand* command = (const BindTextureCommand*)payload;
+			command->Object->Bind(command->Unit);
+			break;
+		}
+
+		case CommandType::SetBlend:
+		{
+			const SetBlendCommand* command = (const SetBlendCommand*)payload;
+			GLStateCache::SetBlendEnabled(command->Enabled != 0);
+			if (command->Enabled)
+				GLStateCache::SetBlendFunc(command->Source, command->Destination);
+			break;
+		}
+
+		case CommandType::SetUniform1i:
+		{
+			const SetUniform1iCommand* command = (const SetUniform1iCommand*)payload;
+			ASSERT(shader);
+			shader->SetUniform1i(command->Target.Resolve(*shader), command->Value);
+			break;
+		}
+
+		case CommandType::SetUniform4f:
+		{
+			const SetUniform4fCommand* command = (const SetUniform4fCommand*)payload;
+			ASSERT(shader);
+			shader->SetUniform4f(command->Target.Resolve(*shader), command->Value[0], command->Value[1], command->Value[2], command->Value[3]);
+			break;
+		}
+
+		case CommandType::SetUniformMat4f:
+		{
+			const SetUniformMat4fCommand* command = (const SetUniformMat4fCommand*)payload;
+			ASSERT(shader);
+			shader->SetUniformMat4f(command->Target.Resolve(*shader), command->Value);
+			break;
+		}
+
+		case CommandType::UpdateBuffer:
+		{
+			const UpdateBufferCommand* command = (const UpdateBufferCommand*)payload;
+			command->Buffer->Update((const unsigned char*)payload + sizeof(UpdateBufferCommand), command->Size, command->Offset);
+			break;
+		}
+
+		case CommandType::DrawIndexed:
+		{
+			const DrawIndexedCommand* command = (const DrawIndexedCommand*)payload;
+			ASSERT(indexBuffer);
+			if (command->BaseVertex != 0)
+			{
+				GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, command->IndexCount, indexBuffer->GetType(), nullptr, command->BaseVertex));
+			}
+			else
+			{
+				GLCall(glDrawElements(GL_TRIANGLES, command->IndexCount, indexBuffer->GetType(), nullptr));
+			}
+			break;
+		}
+		}
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "Shader.h"
+
+class VertexArray;
+class IndexBuffer;
+class VertexBuffer;
+class Texture;
+
+// Draws, binds, uniform writes and buffer uploads recorded into a compact binary stream.
+// Recording makes no GL call and touches nothing shared, so each worker thread can fill its
+// own buffer; the GL thread then replays the buffers with Execute in the order it chooses.
+// The objects referenced by a recording must outlive its replay, and uniform names must be
+// string literals (only their hash and pointer are stored).
+class CommandBuffer
+{
+public:
+	enum class CommandType : unsigned int
+	{
+		BindShader, BindVertexArray, BindIndexBuffer, BindTexture, SetBlend,
+		SetUniform1i, SetUniform4f, SetUniformMat4f, UpdateBuffer, DrawIndexed
+	};
+
+	CommandBuffer(unsigned int reservedBytes = 64 * 1024);
+
+	void Reset();  // drops the commands, keeps the memory
+
+	void BindShader(Shader& shader);
+	void BindVertexArray(const VertexArray& va);
+	void BindIndexBuffer(const IndexBuffer& ib);
+	void BindTexture(const Texture& texture, unsigned int unit);
+	void SetBlend(bool enabled, unsigned int source, unsigned int destination);
+
+	// Apply to the shader bound by the last BindShader of the stream. By name the uniform is
+	// looked up at every replay; a handle must come from that shader and needs no lookup.
+	void SetUniform1i(UniformID id, int value);
+	void SetUniform4f(UniformID id, float v0, float v1, float v2, float v3);
+	void SetUniformMat4f(UniformID id, const glm::mat4& matrix);
+	void SetUniform1i(UniformHandle handle, int value);
+	void SetUniform4f(UniformHandle handle, float v0, float v1, float v2, float v3);
+	void SetUniformMat4f(UniformHandle handle, const glm::mat4& matrix);
+
+	void UpdateBuffer(VertexBuffer& vb, const void* data, unsigned int size, unsigned int offset = 0);  // the data is copied
+	void DrawIndexed(unsigned int indexCount, int baseVertex = 0);  // triangles with the bound vertex array and index buffer
+
+	// GL thread only
+	void Execute() const;
+
+	inline unsigned int GetCommandCount() const { return m_CommandCount; }
+	inline unsigned int GetSize() const { return (unsigned int)m_Data.size(); }
+
+private:
+	struct CommandHeader
+	{
+		CommandType Type;
+		unsigned int Size;  // payload bytes, a multiple of 8
+	};
+
+	void* Allocate(CommandType type, unsigned int size);  // room for a payload of size bytes
+
+	std::vector<unsigned char> m_Data;
+	unsigned int m_CommandCount;
+};
@@ -0,0 +1,79 @@
+#include "DrawIndirectBuffer.h"
+#include "Renderer.h"
+
+DrawIndirectBuffer::DrawIndirectBuffer(unsigned int capacity)
+	: m_Capacity(capacity), m_UploadedCount(0)
+{
+	static_assert(sizeof(DrawElementsIndirectCommand) == 5 * sizeof(GLuint), "indirect commands must be tightly packed");
+
+	if (Renderer::GetCapabilities().DirectStateAccess)
+	{
+		GLCall(glCreateBuffers(1, &m_RendererID));
+		GLCall(glNamedBufferData(m_RendererID, m_Capacity * sizeof(DrawElementsIndirectCommand), nullptr, GL_DYNAMIC_DRAW));
+	}
+	else
+	{
+		GLCall(glGenBuffers(1, &m_RendererID));
+		GLStateCache::BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_RendererID);
+		GLCall(glBufferData(GL_DRAW_INDIRECT_BUFFER, m_Capacity * sizeof(DrawElementsIndirectCommand), nullptr, GL_DYNAMIC_DRAW));
+	}
+	m_Commands.reserve(m_Capacity);
+}
+
+DrawIndirectBuffer::~DrawIndirectBuffer()
+{
+	GLCall(glDeleteBuffers(1, &m_RendererID));
+	GLStateCache::OnBufferDeleted(m_RendererID);
+}
+
+void DrawIndirectBuffer::Clear()
+{
+	m_Commands.clear();
+}
+
+void DrawIndirectBuffer::Add(const DrawElementsIndirectCommand & command)
+{
+	m_Commands.push_back(command);
+}
+
+void DrawIndirectBuffer::Upload()
+{
+	const unsigned int count = (unsigned int)m_Commands.size();
+
+	if (Renderer::GetCapabilities().DirectStateAccess)
+	{
+		if (count > m_Capacity)
+		{
+			m_Capacity = count;
+			GLCall(glNamedBufferData(m_RendererID, m_Capacity * sizeof(DrawElementsIndirectCommand), m_Commands.data(), GL_DYNAMIC_DRAW));
+		}
+		else if (count > 0)
+		{
+			GLCall(glNamedBufferSubData(m_RendererID, 0, count * sizeof(DrawElementsIndirectCommand), m_Commands.data()));
+		}
+		m_UploadedCount = count;
+		return;
+	}
+
+	Bind();
+	if (count > m_Capacity)
+	{
+		m_Capacity = count;
+		GLCall(glBufferData(GL_DRAW_INDIRECT_BUFFER, m_Capacity * sizeof(DrawElementsIndirectCommand), m_Commands.data(), GL_DYNAMIC_DRAW));
+	}
+	else if (count > 0)
+	{
+		GLCall(glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, count * sizeof(DrawElementsIndirectCommand), m_Commands.data()));
+	}
+	m_UploadedCount = count;
+}
+
+void DrawIndirectBuffer::Bind() const
+{
+	GLStateCache::BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_RendererID);
+}
+
+void DrawIndirectBuffer::Unbind() const
+{
+	GLStateCache::BindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
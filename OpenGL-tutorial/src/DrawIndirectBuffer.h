@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vector>
+
+// Layout defined by the GL spec for glMultiDrawElementsIndirect
+struct DrawElementsIndirectCommand
+{
+	unsigned int Count;          // indices per instance
+	unsigned int InstanceCount;
+	unsigned int FirstIndex;     // in indices, not bytes
+	int BaseVertex;
+	unsigned int BaseInstance;   // offsets the instanced attributes
+};
+
+// Collects indirect draw records on the CPU and uploads them to a GL_DRAW_INDIRECT_BUFFER,
+// so that every command can be submitted with a single glMultiDrawElementsIndirect.
+class DrawIndirectBuffer
+{
+private:
+	unsigned int m_RendererID;
+	unsigned int m_Capacity;       // commands the GPU buffer can hold
+	std::vector<DrawElementsIndirectCommand> m_Commands;
+	unsigned int m_UploadedCount;  // commands in the GPU buffer
+
+public:
+	DrawIndirectBuffer(unsigned int capacity = 256);
+	~DrawIndirectBuffer();
+
+	void Clear();
+	void Add(const DrawElementsIndirectCommand& command);
+	void Upload();  // copies the recorded commands to the GPU, growing the buffer if needed
+
+	void Bind() const;
+	void Unbind() const;
+
+	inline unsigned int GetID() const { return m_RendererID; }
+	inline unsigned int GetCount() const { return m_UploadedCount; }
+	inline const std::vector<DrawElementsIndirectCommand>& GetCommands() const { return m_Commands; }
+};
@@ -0,0 +1,254 @@
+#include "Font.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+// ImGui compiles its own copy of stb_truetype with static linkage, this one stays in this file too
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imgui/imstb_rectpack.h"
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "imgui/imstb_truetype.h"
+
+// Distance in atlas pixels covered by the 0..1 range of an SDF glyph, and the empty border it needs
+static const int SDFSpread = 6;
+
+struct SDFPoint
+{
+	int dx, dy;  // offset to the nearest seed pixel
+	int Distance2() const { return dx * dx + dy * dy; }
+};
+
+static void Compare(std::vector<SDFPoint>& grid, int width, int height, SDFPoint& point, int x, int y, int offsetX, int offsetY)
+{
+	const int nx = x + offsetX, ny = y + offsetY;
+	if (nx < 0 || ny < 0 || nx >= width || ny >= height)
+		return;
+
+	SDFPoint other = grid[ny * width + nx];
+	other.dx += offsetX;
+	other.dy += offsetY;
+	if (other.Distance2() < point.Distance2())
+		point = other;
+}
+
+// 8-point sequential Euclidean distance transform: two sweeps propagate the nearest seed offsets
+static void DistanceTransform(std::vector<SDFPoint>& grid, int width, int height)
+{
+	for (int y = 0; y < height; ++y)
+	{
+		for (int x = 0; x < width; ++x)
+		{
+			SDFPoint& p = grid[y * width + x];
+			Compare(grid, width, height, p, x, y, -1, 0);
+			Compare(grid, width, height, p, x, y, 0, -1);
+			Compare(grid, width, height, p, x, y, -1, -1);
+			Compare(grid, width, height, p, x, y, 1, -1);
+		}
+		for (int x = width - 1; x >= 0; --x)
+			Compare(grid, width, height, grid[y * width + x], x, y, 1, 0);
+	}
+
+	for (int y = height - 1; y >= 0; --y)
+	{
+		for (int x = width - 1; x >= 0; --x)
+		{
+			SDFPoint& p = grid[y * width + x];
+			Compare(grid, width, height, p, x, y, 1, 0);
+			Compare(grid, width, height, p, x, y, 0, 1);
+			Compare(grid, width, height, p, x, y, -1, 1);
+			Compare(grid, width, height, p, x, y, 1, 1);
+		}
+		for (int x = 0; x < width; ++x)
+			Compare(grid, width, height, grid[y * width + x], x, y, -1, 0);
+	}
+}
+
+// Turns a coverage bitmap (with a SDFSpread border) into a signed distance field, in place
+static void CoverageToSDF(unsigned char* pixels, int width, int height, int stride)
+{
+	const SDFPoint seed = { 0, 0 }, far = { 1 << 12, 1 << 12 };
+	std::vector<SDFPoint> toInside(width * height), toOutside(width * height);
+	for (int y = 0; y < height; ++y)
+	{
+		for (int x = 0; x < width; ++x)
+		{
+			const bool inside = pixels[y * stride + x] >= 128;
+			toInside[y * width + x] = inside ? seed : far;
+			toOutside[y * width + x] = inside ? far : seed;
+		}
+	}
+
+	DistanceTransform(toInside, width, height);
+	DistanceTransform(toOutside, width, height);
+
+	for (int y = 0; y < height; ++y)
+	{
+		for (int x = 0; x < width; ++x)
+		{
+			// Positive inside; 0.5 on the outline
+			const float distance = sqrtf((float)toOutside[y * width + x].Distance2()) - sqrtf((float)toInside[y * width + x].Distance2());
+			float value = 0.5f + distance / (2.0f * SDFSpread);
+			value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+			pixels[y * stride + x] = (unsigned char)(value * 255.0f + 0.5f);
+		}
+	}
+}
+
+Font::Font(const std::string& filepath, float pixelHeight, bool sdf)
+	: m_Info(std::make_unique<stbtt_fontinfo>()), m_Scale(0.0f),
+	m_PixelHeight(pixelHeight), m_SDF(sdf), m_Ascent(0.0f), m_LineHeight(0.0f)
+{
+	std::ifstream stream(filepath, std::ios::binary);
+	m_FontData.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+	if (m_FontData.empty() || !stbtt_InitFont(m_Info.get(), m_FontData.data(), stbtt_GetFontOffsetForIndex(m_FontData.data(), 0)))
+	{
+		std::cout << "Failed to load font '" << filepath << "'\n";
+		return;
+	}
+
+	m_Scale = stbtt_ScaleForPixelHeight(m_Info.get(), pixelHeight);
+	int ascent, descent, lineGap;
+	stbtt_GetFontVMetrics(m_Info.get(), &ascent, &descent, &lineGap);
+	m_Ascent = ascent * m_Scale;
+	m_LineHeight = (ascent - descent + lineGap) * m_Scale;
+
+	// Glyph boxes, padded so that bilinear filtering (or the distance field) never reads a neighbour
+	const int padding = sdf ? SDFSpread : 1;
+	const unsigned int glyphCount = LastCodepoint - FirstCodepoint + 1;
+	m_Glyphs.resize(glyphCount);
+	std::vector<stbrp_rect> rects(glyphCount);
+	for (unsigned int i = 0; i < glyphCount; ++i)
+	{
+		Glyph& glyph = m_Glyphs[i];
+		glyph = {};
+		const unsigned int codepoint = FirstCodepoint + i;
+		glyph.GlyphIndex = (codepoint >= 127 && codepoint < 160) ? 0 : stbtt_FindGlyphIndex(m_Info.get(), codepoint);
+		if (glyph.GlyphIndex == 0)
+		{
+			// Control characters and glyphs the font lacks take no atlas space
+			rects[i].id = i;
+			rects[i].w = rects[i].h = 0;
+			continue;
+		}
+
+		int advance, leftSideBearing, x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+		stbtt_GetGlyphHMetrics(m_Info.get(), glyph.GlyphIndex, &advance, &leftSideBearing);
+		stbtt_GetGlyphBitmapBox(m_Info.get(), glyph.GlyphIndex, m_Scale, m_Scale, &x0, &y0, &x1, &y1);
+		glyph.Advance = advance * m_Scale;
+		glyph.OffsetX = (float)(x0 - padding);
+		glyph.OffsetY = (float)(y0 - padding);
+		glyph.Width = (float)(x1 - x0 + 2 * padding);
+		glyph.Height = (float)(y1 - y0 + 2 * padding);
+
+		rects[i].id = i;
+		rects[i].w = (stbrp_coord)glyph.Width;
+		rects[i].h = (stbrp_coord)glyph.Height;
+	}
+
+	// Grow the atlas until every glyph fits
+	int width = 256, height = 256;
+	std::vector<stbrp_node> nodes;
+	for (;;)
+	{
+		nodes.resize(width);
+		stbrp_context context;
+		stbrp_init_target(&context, width, height, nodes.data(), (int)nodes.size());
+		if (stbrp_pack_rects(&context, rects.data(), (int)rects.size()))
+			break;
+		if (width == height)
+			height *= 2;
+		else
+			width *= 2;
+	}
+
+	std::vector<unsigned char> coverage(width * height, 0);
+	for (unsigned int i = 0; i < glyphCount; ++i)
+	{
+		Glyph& glyph = m_Glyphs[i];
+		const stbrp_rect& rect = rects[i];
+		if (glyph.GlyphIndex == 0)
+			continue;
+
+		unsigned char* pixels = &coverage[(rect.y + padding) * width + rect.x + padding];
+		stbtt_MakeGlyphBitmap(m_Info.get(), pixels, rect.w - 2 * padding, rect.h - 2 * padding, width, m_Scale, m_Scale, glyph.GlyphIndex);
+		if (sdf)
+			CoverageToSDF(&coverage[rect.y * width + rect.x], rect.w, rect.h, width);
+
+		glyph.U0 = (float)rect.x / width;
+		glyph.V0 = (float)rect.y / height;
+		glyph.U1 = (float)(rect.x + rect.w) / width;
+		glyph.V1 = (float)(rect.y + rect.h) / height;
+	}
+
+	// White texels with the coverage (or distance) in alpha, so the sprite shader tints them like any texture
+	std::vector<unsigned int> rgba(width * height);
+	for (int i = 0; i < width * height; ++i)
+		rgba[i] = 0x00ffffff | ((unsigned int)coverage[i] << 24);
+	m_Atlas = std::make_unique<Texture>(width, height, rgba.data());
+}
+
+Font::~Font()
+{
+}
+
+unsigned int Font::DecodeUTF8(const std::string& text, size_t& i)
+{
+	const unsigned char first = text[i++];
+	if (first < 0x80)
+		return first;
+
+	// Lead byte gives the length, continuation bytes carry 6 bits each
+	const int extra = first >= 0xf0 ? 3 : (first >= 0xe0 ? 2 : 1);
+	unsigned int codepoint = first & (0x3f >> extra);
+	for (int k = 0; k < extra && i < text.size(); ++k)
+		codepoint = (codepoint << 6) | (text[i++] & 0x3f);
+	return codepoint;
+}
+
+const Glyph* Font::GetGlyph(unsigned int codepoint) const
+{
+	if (!IsLoaded() || codepoint < FirstCodepoint || codepoint > LastCodepoint)
+		return nullptr;
+	const Glyph& glyph = m_Glyphs[codepoint - FirstCodepoint];
+	return glyph.GlyphIndex != 0 ? &glyph : nullptr;
+}
+
+float Font::GetKerning(const Glyph& left, const Glyph& right) const
+{
+	return stbtt_GetGlyphKernAdvance(m_Info.get(), left.GlyphIndex, right.GlyphIndex) * m_Scale;
+}
+
+glm::vec2 Font::MeasureText(const std::string& text, float pixelHeight) const
+{
+	const float scale = pixelHeight / m_PixelHeight;
+	float lineWidth = 0.0f, width = 0.0f;
+	unsigned int lines = 1;
+	const Glyph* previous = nullptr;
+
+	for (size_t i = 0; i < text.size();)
+	{
+		const unsigned int c = DecodeUTF8(text, i);
+		if (c == '\n')
+		{
+			width = std::max(width, lineWidth);
+			lineWidth = 0.0f;
+			lines++;
+			previous = nullptr;
+			continue;
+		}
+
+		const Glyph* glyph = GetGlyph(c);
+		if (!glyph)
+			continue;
+		if (previous)
+			lineWidth += GetKerning(*previous, *glyph) * scale;
+		lineWidth += glyph->Advance * scale;
+		previous = glyph;
+	}
+
+	return glm::vec2(std::max(width, lineWidth), lines * m_LineHeight * scale);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "Texture.h"
+
+// Placement of a baked glyph, in pixels at the size the font was baked at
+struct Glyph
+{
+	int GlyphIndex;          // font-internal index, used for kerning
+	float OffsetX, OffsetY;  // top left of the bitmap from the pen position, y pointing down
+	float Width, Height;
+	float Advance;
+	float U0, V0, U1, V1;    // atlas rect, (U0, V0) is the top left texel
+};
+
+// TrueType font baked into an atlas texture with the stb_truetype copy vendored by ImGui.
+// The atlas holds printable ASCII and Latin-1. With sdf set, glyphs are stored as signed
+// distance fields (edge at 0.5) that Renderer2D draws sharp at any scale.
+class Font
+{
+public:
+	Font(const std::string& filepath, float pixelHeight, bool sdf = false);
+	~Font();
+
+	inline bool IsLoaded() const { return m_Atlas != nullptr; }
+	inline bool IsSDF() const { return m_SDF; }
+	inline float GetPixelHeight() const { return m_PixelHeight; }
+	inline float GetAscent() const { return m_Ascent; }
+	inline float GetLineHeight() const { return m_LineHeight; }
+	inline const Texture& GetAtlas() const { return *m_Atlas; }
+
+	// nullptr for codepoints that weren't baked (control characters, or missing from the font)
+	const Glyph* GetGlyph(unsigned int codepoint) const;
+	// Pen adjustment between two consecutive glyphs, in pixels at the baked size
+	float GetKerning(const Glyph& left, const Glyph& right) const;
+	// Size of the laid out text when drawn at pixelHeight
+	glm::vec2 MeasureText(const std::string& text, float pixelHeight) const;
+
+	// Reads the UTF-8 sequence starting at text[i] and moves i past it
+	static unsigned int DecodeUTF8(const std::string& text, size_t& i);
+
+private:
+	static const unsigned int FirstCodepoint = 32;
+	static const unsigned int LastCodepoint = 255;
+
+	std::vector<unsigned char> m_FontData;  // stb_truetype reads the file in place, for kerning
+	std::unique_ptr<struct stbtt_fontinfo> m_Info;
+	float m_Scale;
+
+	float m_PixelHeight;
+	bool m_SDF;
+	float m_Ascent;
+	float m_LineHeight;
+	std::vector<Glyph> m_Glyphs;  // index codepoint - FirstCodepoint, GlyphIndex 0 when not baked
+	std::unique_ptr<Texture> m_Atlas;
+};
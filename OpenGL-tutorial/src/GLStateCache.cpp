@@ -0,0 +1,271 @@
+#include "GLStateCache.h"
+
+#include "Renderer.h"
+
+#include <unordered_map>
+#include <vector>
+
+static const unsigned int Unknown = 0xffffffff;
+
+struct GLStateData
+{
+	unsigned int Program = Unknown;
+	unsigned int VertexArray = Unknown;
+	unsigned int ArrayBuffer = Unknown;
+	unsigned int DrawIndirectBuffer = Unknown;
+	unsigned int UniformBuffer = Unknown;  // generic binding, glBindBufferBase sets it too
+	std::unordered_map<unsigned int, unsigned int> ElementBuffers;  // vertex array -> element buffer
+	unsigned int ActiveUnit = Unknown;
+	std::vector<unsigned int> Textures;  // per unit
+	int BlendEnabled = -1;  // -1 unknown
+	GLenum BlendSource = Unknown, BlendDestination = Unknown;
+	float ClearColor[4] = { -1.0f, -1.0f, -1.0f, -1.0f };
+	bool ClearColorKnown = false;
+
+	GLStateStats Stats;
+};
+
+static GLStateData s_State;
+
+// Counts the call and tells whether it has to reach the driver
+static bool Changes(unsigned int& current, unsigned int value)
+{
+	if (current == value)
+	{
+		s_State.Stats.SkippedCalls++;
+		return false;
+	}
+	current = value;
+	s_State.Stats.IssuedCalls++;
+	return true;
+}
+
+static void SetActiveUnit(unsigned int unit)
+{
+	if (Changes(s_State.ActiveUnit, unit))
+	{
+		GLCall(glActiveTexture(GL_TEXTURE0 + unit));
+	}
+}
+
+void GLStateCache::UseProgram(unsigned int program)
+{
+	if (Changes(s_State.Program, program))
+	{
+		GLCall(glUseProgram(program));
+	}
+}
+
+void GLStateCache::BindVertexArray(unsigned int vertexArray)
+{
+	if (Changes(s_State.VertexArray, vertexArray))
+	{
+		GLCall(glBindVertexArray(vertexArray));
+	}
+}
+
+void GLStateCache::BindBuffer(GLenum target, unsigned int buffer)
+{
+	switch (target)
+	{
+	case GL_ARRAY_BUFFER:
+		if (Changes(s_State.ArrayBuffer, buffer))
+		{
+			GLCall(glBindBuffer(target, buffer));
+		}
+		break;
+
+	case GL_ELEMENT_ARRAY_BUFFER:
+	{
+		// Binding it edits the current vertex array, which must therefore be known
+		if (s_State.VertexArray == Unknown)
+		{
+			GLCall(glBindBuffer(target, buffer));
+			s_State.Stats.IssuedCalls++;
+			break;
+		}
+		auto it = s_State.ElementBuffers.emplace(s_State.VertexArray, Unknown).first;
+		if (Changes(it->second, buffer))
+		{
+			GLCall(glBindBuffer(target, buffer));
+		}
+		break;
+	}
+
+	case GL_DRAW_INDIRECT_BUFFER:
+		if (Changes(s_State.DrawIndirectBuffer, buffer))
+		{
+			GLCall(glBindBuffer(target, buffer));
+		}
+		break;
+
+	case GL_UNIFORM_BUFFER:
+		if (Changes(s_State.UniformBuffer, buffer))
+		{
+			GLCall(glBindBuffer(target, buffer));
+		}
+		break;
+
+	default:
+		GLCall(glBindBuffer(target, buffer));
+		s_State.Stats.IssuedCalls++;
+		break;
+	}
+}
+
+void GLStateCache::BindBufferBase(GLenum target, unsigned int index, unsigned int buffer)
+{
+	GLCall(glBindBufferBase(target, index, buffer));
+	s_State.Stats.IssuedCalls++;
+	if (target == GL_UNIFORM_BUFFER)
+		s_State.UniformBuffer = buffer;
+}
+
+void GLStateCache::BindTexture(unsigned int unit, unsigned int texture)
+{
+	if (unit >= s_State.Textures.size())
+		s_State.Textures.resize(unit + 1, Unknown);
+
+	if (s_State.Textures[unit] == texture)
+	{
+		s_State.Stats.SkippedCalls++;
+		return;
+	}
+
+	Changes(s_State.Textures[unit], texture);
+	if (Renderer::GetCapabilities().DirectStateAccess)
+	{
+		GLCall(glBindTextureUnit(unit, texture));  // the active unit is left alone
+		return;
+	}
+
+	SetActiveUnit(unit);
+	GLCall(glBindTexture(GL_TEXTURE_2D, texture));
+}
+
+void GLStateCache::BindTextureForEdit(unsigned int texture)
+{
+	if (s_State.ActiveUnit == Unknown)
+		SetActiveUnit(0);
+	BindTexture(s_State.ActiveUnit, texture);
+}
+
+void GLStateCache::SetBlendEnabled(bool enabled)
+{
+	if (s_State.BlendEnabled == (int)enabled)
+	{
+		s_State.Stats.SkippedCalls++;
+		return;
+	}
+
+	s_State.BlendEnabled = enabled;
+	s_State.Stats.IssuedCalls++;
+	if (enabled)
+	{
+		GLCall(glEnable(GL_BLEND));
+	}
+	else
+	{
+		GLCall(glDisable(GL_BLEND));
+	}
+}
+
+void GLStateCache::SetBlendFunc(GLenum source, GLenum destination)
+{
+	if (s_State.BlendSource == source && s_State.BlendDestination == destination)
+	{
+		s_State.Stats.SkippedCalls++;
+		return;
+	}
+
+	s_State.BlendSource = source;
+	s_State.BlendDestination = destination;
+	s_State.Stats.IssuedCalls++;
+	GLCall(glBlendFunc(source, destination));
+}
+
+void GLStateCache::SetClearColor(float r, float g, float b, float a)
+{
+	float* color = s_State.ClearColor;
+	if (s_State.ClearColorKnown && color[0] == r && color[1] == g && color[2] == b && color[3] == a)
+	{
+		s_State.Stats.SkippedCalls++;
+		return;
+	}
+
+	color[0] = r;
+	color[1] = g;
+	color[2] = b;
+	color[3] = a;
+	s_State.ClearColorKnown = true;
+	s_State.Stats.IssuedCalls++;
+	GLCall(glClearColor(r, g, b, a));
+}
+
+void GLStateCache::OnProgramDeleted(unsigned int program)
+{
+	// glDeleteProgram keeps a bound program alive until it is replaced, as if nothing was bound
+	if (s_State.Program == program)
+		s_State.Program = Unknown;
+}
+
+void GLStateCache::OnVertexArrayDeleted(unsigned int vertexArray)
+{
+	// Deleting the bound vertex array binds 0
+	if (s_State.VertexArray == vertexArray)
+		s_State.VertexArray = 0;
+	s_State.ElementBuffers.erase(vertexArray);
+}
+
+void GLStateCache::OnBufferDeleted(unsigned int buffer)
+{
+	// Deleting a buffer unbinds it from the context and from the bound vertex array only,
+	// other vertex arrays keep the old object: a new buffer with the same name must be bound again
+	if (s_State.ArrayBuffer == buffer)
+		s_State.ArrayBuffer = 0;
+	if (s_State.DrawIndirectBuffer == buffer)
+		s_State.DrawIndirectBuffer = 0;
+	if (s_State.UniformBuffer == buffer)
+		s_State.UniformBuffer = 0;
+	for (auto& entry : s_State.ElementBuffers)
+	{
+		if (entry.second == buffer)
+			entry.second = entry.first == s_State.VertexArray ? 0 : Unknown;
+	}
+}
+
+void GLStateCache::OnTextureDeleted(unsigned int texture)
+{
+	// Deleting a texture binds 0 on every unit it was bound to
+	for (unsigned int& bound : s_State.Textures)
+	{
+		if (bound == texture)
+			bound = 0;
+	}
+}
+
+void GLStateCache::Invalidate()
+{
+	s_State.Program = Unknown;
+	s_State.VertexArray = Unknown;
+	s_State.ArrayBuffer = Unknown;
+	s_State.DrawIndirectBuffer = Unknown;
+	s_State.UniformBuffer = Unknown;
+	s_State.ElementBuffers.clear();
+	s_State.ActiveUnit = Unknown;
+	s_State.Textures.clear();
+	s_State.BlendEnabled = -1;
+	s_State.BlendSource = Unknown;
+	s_State.BlendDestination = Unknown;
+	s_State.ClearColorKnown = false;
+}
+
+const GLStateStats& GLStateCache::GetStats()
+{
+	return s_State.Stats;
+}
+
+void GLStateCache::ResetStats()
+{
+	s_State.Stats = GLStateStats();
+}
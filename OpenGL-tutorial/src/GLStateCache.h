@@ -0,0 +1,43 @@
+#pragma once
+
+#include <GL/glew.h>
+
+// Calls that went to the driver and calls dropped because the state was already set
+struct GLStateStats
+{
+	unsigned int IssuedCalls = 0;
+	unsigned int SkippedCalls = 0;
+};
+
+// Mirror of the GL state the renderer touches: bound program, vertex array, buffers, active
+// texture unit, per-unit 2D textures, blending and clear color. Every bind goes through here
+// and is dropped when it would not change anything. The element buffer belongs to the vertex
+// array, so it is remembered per vertex array.
+// Code that changes GL state behind the cache's back (ImGui's backend) must call Invalidate.
+// Single context, GL thread only.
+class GLStateCache
+{
+public:
+	static void UseProgram(unsigned int program);
+	static void BindVertexArray(unsigned int vertexArray);
+	static void BindBuffer(GLenum target, unsigned int buffer);  // GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, GL_DRAW_INDIRECT_BUFFER or GL_UNIFORM_BUFFER
+	static void BindBufferBase(GLenum target, unsigned int index, unsigned int buffer);  // indexed binding, moves the generic one too
+	static void BindTexture(unsigned int unit, unsigned int texture);  // GL_TEXTURE_2D on the unit
+	static void BindTextureForEdit(unsigned int texture);  // on whatever unit is active, for glTexParameter and uploads
+
+	static void SetBlendEnabled(bool enabled);
+	static void SetBlendFunc(GLenum source, GLenum destination);
+	static void SetClearColor(float r, float g, float b, float a);
+
+	// Deleted names are reused by the driver, the cache must not believe they are still bound
+	static void OnProgramDeleted(unsigned int program);
+	static void OnVertexArrayDeleted(unsigned int vertexArray);
+	static void OnBufferDeleted(unsigned int buffer);
+	static void OnTextureDeleted(unsigned int texture);
+
+	// Forgets everything: the next call of each kind reaches the driver
+	static void Invalidate();
+
+	static const GLStateStats& GetStats();
+	static void ResetStats();
+};
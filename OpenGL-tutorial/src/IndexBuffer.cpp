@@ -1,27 +1,100 @@
 #include "IndexBuffer.h"
 #include "Renderer.h"
 
+#include <vector>
+
 IndexBuffer::IndexBuffer(const unsigned int *data, unsigned int count)
-	: m_Count(count)
+	: m_Count(count), m_Type(GL_UNSIGNED_INT)
 {
 	ASSERT(sizeof(unsigned int) == sizeof(GLuint));
 
+	Create(data, count * sizeof(GLuint));
+}
+
+IndexBuffer::IndexBuffer(const unsigned short *data, unsigned int count)
+	: m_Count(count), m_Type(GL_UNSIGNED_SHORT)
+{
+	ASSERT(sizeof(unsigned short) == sizeof(GLushort));
+
+	Create(data, count * sizeof(GLushort));	// Half the size of 32-bit indices
+}
+
+void IndexBuffer::Create(const void* data, unsigned int size)
+{
+	if (Renderer::GetCapabilities().DirectStateAccess)
+	{
+		// Not bound: the vertex array that happens to be bound keeps its element buffer
+		GLCall(glCreateBuffers(1, &m_RendererID));
+		GLCall(glNamedBufferData(m_RendererID, size, data, GL_STATIC_DRAW));
+		return;
+	}
+
 	GLCall(glGenBuffers(1, &m_RendererID));	// Create a buffer and returns the buffer id
-	GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID));
-	GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, count*sizeof(GLuint), data, GL_STATIC_DRAW));	// Put data in the buffer
+	GLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+	GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));	// Put data in the buffer
 }
 
 IndexBuffer::~IndexBuffer()
 {
 	GLCall(glDeleteBuffers(1, &m_RendererID));
+	GLStateCache::OnBufferDeleted(m_RendererID);
 }
 
 void IndexBuffer::Bind() const
 {
-	GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID));
+	GLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
 }
 
 void IndexBuffer::Unbind() const
 {
-	GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+	GLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+template<typename T>
+static std::vector<T> GenerateQuadIndices(unsigned int quadCount)
+{
+	std::vector<T> indices(quadCount * 6);
+	unsigned int offset = 0;
+	for (unsigned int i = 0; i < quadCount * 6; i += 6)
+	{
+		indices[i + 0] = (T)(offset + 0);
+		indices[i + 1] = (T)(offset + 1);
+		indices[i + 2] = (T)(offset + 2);
+
+		indices[i + 3] = (T)(offset + 2);
+		indices[i + 4] = (T)(offset + 3);
+		indices[i + 5] = (T)(offset + 0);
+
+		offset += 4;
+	}
+	return indices;
+}
+
+std::shared_ptr<IndexBuffer> IndexBuffer::GetQuadIndexBuffer(unsigned int quadCount)
+{
+	static const unsigned int MaxShortQuads = 65536 / 4;
+
+	static std::weak_ptr<IndexBuffer> s_QuadIndexBuffer;
+	static unsigned int s_QuadCapacity = 0;
+
+	std::shared_ptr<IndexBuffer> ib = s_QuadIndexBuffer.lock();
+	if (ib && s_QuadCapacity >= quadCount)
+		return ib;
+
+	// Small requests are rounded up to the largest 16-bit buffer so that every batcher can share it
+	if (quadCount <= MaxShortQuads)
+	{
+		std::vector<unsigned short> indices = GenerateQuadIndices<unsigned short>(MaxShortQuads);
+		ib = std::make_shared<IndexBuffer>(indices.data(), (unsigned int)indices.size());
+		s_QuadCapacity = MaxShortQuads;
+	}
+	else
+	{
+		std::vector<unsigned int> indices = GenerateQuadIndices<unsigned int>(quadCount);
+		ib = std::make_shared<IndexBuffer>(indices.data(), (unsigned int)indices.size());
+		s_QuadCapacity = quadCount;
+	}
+
+	s_QuadIndexBuffer = ib;
+	return ib;
 }
@@ -1,16 +1,27 @@
 #pragma once
 
+#include <memory>
+
 class IndexBuffer
 {
 private:
 	unsigned int m_RendererID;
 	unsigned int m_Count;
+	unsigned int m_Type;  // GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+
+	void Create(const void* data, unsigned int size);
 public:
 	IndexBuffer(const unsigned int *data, unsigned int count);
+	IndexBuffer(const unsigned short *data, unsigned int count);
 	~IndexBuffer();
 
 	void Bind() const;
 	void Unbind() const;
 
 	inline unsigned int GetCount() const { return m_Count; }
-};
\ No newline at end of file
+	inline unsigned int GetType() const { return m_Type; }
+
+	// Returns an index buffer holding the 0, 1, 2, 2, 3, 0 pattern for at least quadCount quads.
+	// The buffer is shared by every caller and uses 16-bit indices when the vertices fit in 65536.
+	static std::shared_ptr<IndexBuffer> GetQuadIndexBuffer(unsigned int quadCount);
+};
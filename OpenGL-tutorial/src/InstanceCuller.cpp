@@ -0,0 +1,38 @@
+#include "InstanceCuller.h"
+
+#include "Renderer.h"
+
+static const unsigned int WorkGroupSize = 256;  // local_size_x of the culling shaders
+
+InstanceCuller::InstanceCuller(const std::string& computeShaderPath)
+{
+	m_Shader = std::make_unique<Shader>(computeShaderPath);
+	m_ViewProjectionUniform = m_Shader->GetUniformHandle("u_ViewProjection");
+	m_InstanceCountUniform = m_Shader->GetUniformHandle("u_InstanceCount");
+}
+
+InstanceCuller::~InstanceCuller()
+{
+}
+
+void InstanceCuller::Cull(const VertexBuffer& input, unsigned int instanceCount, const VertexBuffer& output,
+	DrawIndirectBuffer& commands, unsigned int indexCount, const glm::mat4& viewProjection)
+{
+	// The shader increments instanceCount for every visible instance
+	commands.Clear();
+	commands.Add({ indexCount, 0, 0, 0, 0 });
+	commands.Upload();
+
+	m_Shader->Bind();
+	m_Shader->SetUniformMat4f(m_ViewProjectionUniform, viewProjection);
+	m_Shader->SetUniform1i(m_InstanceCountUniform, instanceCount);
+
+	GLCall(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, input.GetID()));
+	GLCall(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, output.GetID()));
+	GLCall(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, commands.GetID()));
+
+	GLCall(glDispatchCompute((instanceCount + WorkGroupSize - 1) / WorkGroupSize, 1, 1));
+
+	// The draw reads the command as indirect arguments and the instances as vertex attributes
+	GLCall(glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT));
+}
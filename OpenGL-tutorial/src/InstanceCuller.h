@@ -0,0 +1,29 @@
+#pragma once
+
+#include <memory>
+
+#include "glm/glm.hpp"
+
+#include "VertexBuffer.h"
+#include "DrawIndirectBuffer.h"
+#include "Shader.h"
+
+// Frustum culling of instances on the GPU (GL 4.3 compute shaders).
+// The compute shader copies the visible instances to a second buffer and writes their
+// number in an indirect command, so the CPU never looks at per-object visibility.
+class InstanceCuller
+{
+public:
+	InstanceCuller(const std::string& computeShaderPath);
+	~InstanceCuller();
+
+	// Fills output with the visible instances of input and sets commands to a single
+	// draw of indexCount indices per visible instance. output must hold instanceCount instances.
+	void Cull(const VertexBuffer& input, unsigned int instanceCount, const VertexBuffer& output,
+		DrawIndirectBuffer& commands, unsigned int indexCount, const glm::mat4& viewProjection);
+
+private:
+	std::unique_ptr<Shader> m_Shader;
+	UniformHandle m_ViewProjectionUniform;
+	UniformHandle m_InstanceCountUniform;
+};
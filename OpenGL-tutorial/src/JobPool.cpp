@@ -0,0 +1,96 @@
+#include "JobPool.h"
+
+JobPool::JobPool(unsigned int threadCount)
+	: m_Job(nullptr), m_JobCount(0), m_NextJob(0), m_PendingJobs(0), m_ActiveWorkers(0), m_Generation(0), m_Quit(false)
+{
+	for (unsigned int i = 0; i < threadCount; ++i)
+		m_Threads.emplace_back(&JobPool::WorkerLoop, this);
+}
+
+JobPool::~JobPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Quit = true;
+	}
+	m_WakeCondition.notify_all();
+	for (auto& thread : m_Threads)
+		thread.join();
+}
+
+JobPool& JobPool::Get()
+{
+	static JobPool pool(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 1);
+	return pool;
+}
+
+unsigned int JobPool::RunJobs(const std::function<void(unsigned int)>& job, unsigned int count)
+{
+	unsigned int done = 0;
+	for (unsigned int i = m_NextJob++; i < count; i = m_NextJob++)
+	{
+		job(i);
+		done++;
+	}
+	return done;
+}
+
+void JobPool::Run(unsigned int count, const std::function<void(unsigned int)>& job)
+{
+	if (count == 0)
+		return;
+	if (count == 1 || m_Threads.empty())
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			job(i);
+		return;
+	}
+
+	std::lock_guard<std::mutex> runLock(m_RunMutex);
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Job = &job;
+		m_JobCount = count;
+		m_NextJob = 0;
+		m_PendingJobs = count;
+		m_Generation++;
+	}
+	m_WakeCondition.notify_all();
+
+	const unsigned int done = RunJobs(job, count);
+
+	// Also wait for workers that woke up too late to find a job: once m_Job is cleared none of
+	// them can still be holding on to this run
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	m_PendingJobs -= done;
+	m_DoneCondition.wait(lock, [this] { return m_PendingJobs == 0 && m_ActiveWorkers == 0; });
+	m_Job = nullptr;
+}
+
+void JobPool::WorkerLoop()
+{
+	unsigned int generation = 0;
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	while (true)
+	{
+		m_WakeCondition.wait(lock, [&] { return m_Quit || m_Generation != generation; });
+		if (m_Quit)
+			return;
+		generation = m_Generation;
+		if (!m_Job)
+			continue;  // the run this wake-up was for has already finished
+
+		const std::function<void(unsigned int)>& job = *m_Job;
+		const unsigned int count = m_JobCount;
+		m_ActiveWorkers++;
+		lock.unlock();
+
+		const unsigned int done = RunJobs(job, count);
+
+		lock.lock();
+		m_PendingJobs -= done;
+		m_ActiveWorkers--;
+		if (m_PendingJobs == 0 && m_ActiveWorkers == 0)
+			m_DoneCondition.notify_all();
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Worker threads started once and parked on a condition variable between frames, so that
+// splitting per-frame work costs a wake-up instead of a thread creation.
+// Run hands out jobs 0..count-1 to the workers and the calling thread and returns when all
+// of them are done. Calls to Run are serialized; a job must not call Run itself.
+class JobPool
+{
+public:
+	JobPool(unsigned int threadCount);
+	~JobPool();
+
+	void Run(unsigned int count, const std::function<void(unsigned int)>& job);
+
+	inline unsigned int GetThreadCount() const { return (unsigned int)m_Threads.size(); }
+
+	// Shared by the whole application, one thread per core besides the calling one
+	static JobPool& Get();
+
+private:
+	void WorkerLoop();
+	unsigned int RunJobs(const std::function<void(unsigned int)>& job, unsigned int count);
+
+	std::vector<std::thread> m_Threads;
+
+	std::mutex m_RunMutex;  // one Run at a time
+	std::mutex m_Mutex;     // guards everything below but m_NextJob
+	std::condition_variable m_WakeCondition;
+	std::condition_variable m_DoneCondition;
+
+	const std::function<void(unsigned int)>* m_Job;  // nullptr between runs
+	unsigned int m_JobCount;
+	std::atomic<unsigned int> m_NextJob;
+	unsigned int m_PendingJobs;
+	unsigned int m_ActiveWorkers;  // workers that may still be reading m_Job
+	unsigned int m_Generation;     // bumped by every Run, so a worker wakes once per run
+	bool m_Quit;
+};
@@ -0,0 +1,279 @@
+#include "MeshOptimizer.h"
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+// Size of the LRU cache modelled while scoring, bigger than the real FIFO on purpose
+static const int MaxCacheSize = 32;
+
+static float VertexScore(int cachePosition, unsigned int remainingTriangles)
+{
+	if (remainingTriangles == 0)
+		return -1.0f;  // no triangle left to emit with this vertex
+
+	float score = 0.0f;
+	if (cachePosition >= 0)
+	{
+		// The last triangle's vertices get a fixed score so the next triangle doesn't just reuse its edge
+		if (cachePosition < 3)
+			score = 0.75f;
+		else
+			score = powf(1.0f - (float)(cachePosition - 3) / (MaxCacheSize - 3), 1.5f);
+	}
+
+	// Finishing vertices with few triangles left removes them from the working set early
+	score += 2.0f * powf((float)remainingTriangles, -0.5f);
+	return score;
+}
+
+float ComputeACMR(const unsigned int* indices, unsigned int indexCount, unsigned int vertexCount, unsigned int cacheSize)
+{
+	const unsigned int triangleCount = indexCount / 3;
+	if (triangleCount == 0)
+		return 0.0f;
+
+	// A vertex is in the FIFO while fewer than cacheSize misses happened since it was inserted
+	std::vector<unsigned int> insertedAt(vertexCount, 0);
+	unsigned int time = cacheSize + 1;
+	unsigned int misses = 0;
+
+	for (unsigned int i = 0; i < indexCount; ++i)
+	{
+		const unsigned int v = indices[i];
+		if (time - insertedAt[v] > cacheSize)
+		{
+			insertedAt[v] = time++;
+			misses++;
+		}
+	}
+
+	return (float)misses / triangleCount;
+}
+
+void OptimizeVertexCache(unsigned int* indices, unsigned int indexCount, unsigned int vertexCount)
+{
+	const unsigned int triangleCount = indexCount / 3;
+	if (triangleCount == 0)
+		return;
+
+	const std::vector<unsigned int> input(indices, indices + triangleCount * 3);
+
+	// Triangles using each vertex: adjacency[offset[v], offset[v] + remaining[v]) holds the ones not emitted yet
+	std::vector<unsigned int> remaining(vertexCount, 0);
+	for (unsigned int index : input)
+		remaining[index]++;
+
+	std::vector<unsigned int> offset(vertexCount + 1, 0);
+	for (unsigned int v = 0; v < vertexCount; ++v)
+		offset[v + 1] = offset[v] + remaining[v];
+
+	std::vector<unsigned int> adjacency(input.size());
+	std::vector<unsigned int> fill(offset.begin(), offset.end() - 1);
+	for (unsigned int t = 0; t < triangleCount; ++t)
+	{
+		for (int k = 0; k < 3; ++k)
+			adjacency[fill[input[t * 3 + k]]++] = t;
+	}
+
+	std::vector<int> cachePosition(vertexCount, -1);
+	std::vector<float> vertexScore(vertexCount);
+	for (unsigned int v = 0; v < vertexCount; ++v)
+		vertexScore[v] = VertexScore(-1, remaining[v]);
+
+	std::vector<float> triangleScore(triangleCount);
+	std::vector<bool> emitted(triangleCount, false);
+	for (unsigned int t = 0; t < triangleCount; ++t)
+		triangleScore[t] = vertexScore[input[t * 3]] + vertexScore[input[t * 3 + 1]] + vertexScore[input[t * 3 + 2]];
+
+	unsigned int cache[MaxCacheSize + 3];
+	int cacheCount = 0;
+	unsigned int scanCursor = 0;
+	int best = -1;
+
+	for (unsigned int out = 0; out < triangleCount; ++out)
+	{
+		if (best < 0)
+		{
+			// Nothing adjacent to the cache (start, or a new disconnected piece): take the next triangle left
+			while (emitted[scanCursor])
+				scanCursor++;
+			best = scanCursor;
+		}
+
+		const unsigned int* triangle = &input[best * 3];
+		indices[out * 3 + 0] = triangle[0];
+		indices[out * 3 + 1] = triangle[1];
+		indices[out * 3 + 2] = triangle[2];
+		emitted[best] = true;
+
+		// Drop the triangle from its vertices' lists: swap it with the last one still pending
+		for (int k = 0; k < 3; ++k)
+		{
+			const unsigned int v = triangle[k];
+			unsigned int* list = &adjacency[offset[v]];
+			for (unsigned int i = 0; i < remaining[v]; ++i)
+			{
+				if (list[i] == (unsigned int)best)
+				{
+					list[i] = list[remaining[v] - 1];
+					break;
+				}
+			}
+			remaining[v]--;
+		}
+
+		// Move the triangle's vertices to the front of the LRU cache
+		unsigned int newCache[MaxCacheSize + 3];
+		int newCount = 0;
+		for (int k = 0; k < 3; ++k)
+			newCache[newCount++] = triangle[k];
+		for (int i = 0; i < cacheCount; ++i)
+		{
+			const unsigned int v = cache[i];
+			if (v != triangle[0] && v != triangle[1] && v != triangle[2])
+				newCache[newCount++] = v;
+		}
+
+		// Rescore every vertex that moved, including the ones that just fell out of the cache
+		for (int i = 0; i < newCount; ++i)
+		{
+			const unsigned int v = newCache[i];
+			cachePosition[v] = i < MaxCacheSize ? i : -1;
+			vertexScore[v] = VertexScore(cachePosition[v], remaining[v]);
+		}
+
+		// The next triangle is the best one touching the cache
+		best = -1;
+		float bestScore = -1.0f;
+		for (int i = 0; i < newCount; ++i)
+		{
+			const unsigned int v = newCache[i];
+			const unsigned int* list = &adjacency[offset[v]];
+			for (unsigned int j = 0; j < remaining[v]; ++j)
+			{
+				const unsigned int t = list[j];
+				const unsigned int* other = &input[t * 3];
+				triangleScore[t] = vertexScore[other[0]] + vertexScore[other[1]] + vertexScore[other[2]];
+				if (triangleScore[t] > bestScore)
+				{
+					bestScore = triangleScore[t];
+					best = (int)t;
+				}
+			}
+		}
+
+		cacheCount = newCount < MaxCacheSize ? newCount : MaxCacheSize;
+		memcpy(cache, newCache, cacheCount * sizeof(unsigned int));
+	}
+}
+
+unsigned int OptimizeVertexFetch(void* vertices, unsigned int vertexCount, unsigned int vertexSize, unsigned int* indices, unsigned int indexCount)
+{
+	const unsigned int Unused = ~0u;
+	std::vector<unsigned int> remap(vertexCount, Unused);
+	std::vector<unsigned char> reordered((size_t)vertexCount * vertexSize);
+	const unsigned char* source = (const unsigned char*)vertices;
+
+	unsigned int next = 0;
+	for (unsigned int i = 0; i < indexCount; ++i)
+	{
+		const unsigned int v = indices[i];
+		if (remap[v] == Unused)
+		{
+			remap[v] = next;
+			memcpy(&reordered[(size_t)next * vertexSize], source + (size_t)v * vertexSize, vertexSize);
+			next++;
+		}
+		indices[i] = remap[v];
+	}
+
+	memcpy(vertices, reordered.data(), (size_t)next * vertexSize);
+	return next;
+}
+
+MeshOptimizationStats OptimizeMesh(void* vertices, unsigned int vertexCount, unsigned int vertexSize, unsigned int* indices, unsigned int indexCount)
+{
+	MeshOptimizationStats stats;
+	stats.ACMRBefore = ComputeACMR(indices, indexCount, vertexCount);
+
+	// Triangle order first: the fetch order follows from it
+	OptimizeVertexCache(indices, indexCount, vertexCount);
+	stats.VertexCount = OptimizeVertexFetch(vertices, vertexCount, vertexSize, indices, indexCount);
+
+	stats.ACMRAfter = ComputeACMR(indices, indexCount, stats.VertexCount);
+	return stats;
+}
+
+bool LoadMeshFile(const std::string& filepath, MeshData& mesh)
+{
+	std::ifstream stream(filepath, std::ios::binary);
+	MeshFileHeader header;
+	header.Magic = 0;
+	stream.read((char*)&header, sizeof(header));
+	if (!stream || header.Magic != MeshFileHeader::MagicValue || header.VertexSize == 0)
+	{
+		std::cout << "Failed to load mesh '" << filepath << "'\n";
+		return false;
+	}
+
+	mesh.VertexSize = header.VertexSize;
+	mesh.Vertices.resize((size_t)header.VertexCount * header.VertexSize);
+	mesh.Indices.resize(header.IndexCount);
+	stream.read((char*)mesh.Vertices.data(), mesh.Vertices.size());
+	stream.read((char*)mesh.Indices.data(), mesh.Indices.size() * sizeof(unsigned int));
+	if (!stream)
+	{
+		std::cout << "Mesh '" << filepath << "' is truncated\n";
+		return false;
+	}
+
+	for (unsigned int index : mesh.Indices)
+	{
+		if (index >= header.VertexCount)
+		{
+			std::cout << "Mesh '" << filepath << "' has an index out of range\n";
+			return false;
+		}
+	}
+	return true;
+}
+
+bool SaveMeshFile(const std::string& filepath, const MeshData& mesh)
+{
+	if (mesh.VertexSize == 0)
+		return false;
+
+	MeshFileHeader header;
+	header.VertexSize = mesh.VertexSize;
+	header.VertexCount = (unsigned int)(mesh.Vertices.size() / mesh.VertexSize);
+	header.IndexCount = (unsigned int)mesh.Indices.size();
+
+	std::ofstream stream(filepath, std::ios::binary | std::ios::trunc);
+	stream.write((const char*)&header, sizeof(header));
+	stream.write((const char*)mesh.Vertices.data(), (size_t)header.VertexCount * header.VertexSize);
+	stream.write((const char*)mesh.Indices.data(), mesh.Indices.size() * sizeof(unsigned int));
+	if (!stream)
+	{
+		std::cout << "Failed to write mesh '" << filepath << "'\n";
+		return false;
+	}
+	return true;
+}
+
+bool OptimizeMeshFile(const std::string& inputPath, const std::string& outputPath, MeshOptimizationStats* stats)
+{
+	MeshData mesh;
+	if (!LoadMeshFile(inputPath, mesh))
+		return false;
+
+	const unsigned int vertexCount = (unsigned int)(mesh.Vertices.size() / mesh.VertexSize);
+	MeshOptimizationStats result = OptimizeMesh(mesh.Vertices.data(), vertexCount, mesh.VertexSize, mesh.Indices.data(), (unsigned int)mesh.Indices.size());
+	mesh.Vertices.resize((size_t)result.VertexCount * mesh.VertexSize);  // unreferenced vertices are not written
+	if (stats)
+		*stats = result;
+
+	return SaveMeshFile(outputPath, mesh);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Optimizations for static indexed triangle lists. At load time they run on the mesh data
+// before it is handed to the VertexBuffer/IndexBuffer constructors:
+//
+//     MeshOptimizationStats stats = OptimizeMesh(vertices.data(), vertexCount, sizeof(Vertex), indices.data(), indexCount);
+//     VertexBuffer vb(vertices.data(), stats.VertexCount * sizeof(Vertex));
+//     IndexBuffer ib(indices.data(), indexCount);
+//
+// Offline, OptimizeMeshFile rewrites a mesh file once so that loading it costs nothing:
+//
+//     OpenGL-tutorial --optimize-mesh in.mesh out.mesh
+
+struct MeshOptimizationStats
+{
+	float ACMRBefore = 0.0f;  // average cache miss ratio: vertices transformed per triangle (0.5 is ideal, 3 the worst)
+	float ACMRAfter = 0.0f;
+	unsigned int VertexCount = 0;  // vertices left after unreferenced ones are dropped
+};
+
+// ACMR of the index list for a FIFO post-transform cache of cacheSize vertices
+float ComputeACMR(const unsigned int* indices, unsigned int indexCount, unsigned int vertexCount, unsigned int cacheSize = 16);
+
+// Reorders the triangles for the post-transform cache (Tom Forsyth's linear-speed algorithm).
+// The triangles themselves and their winding are unchanged.
+void OptimizeVertexCache(unsigned int* indices, unsigned int indexCount, unsigned int vertexCount);
+
+// Reorders the vertices in order of first use by the index list so that fetches walk the buffer
+// forward, and rewrites the indices. Returns the number of vertices that are referenced.
+unsigned int OptimizeVertexFetch(void* vertices, unsigned int vertexCount, unsigned int vertexSize, unsigned int* indices, unsigned int indexCount);
+
+// Both of the above, in that order
+MeshOptimizationStats OptimizeMesh(void* vertices, unsigned int vertexCount, unsigned int vertexSize, unsigned int* indices, unsigned int indexCount);
+
+// Mesh file: a MeshFileHeader, then VertexCount * VertexSize bytes of vertices and IndexCount
+// 32-bit indices, all in the byte order of the machine that wrote it
+struct MeshFileHeader
+{
+	static const unsigned int MagicValue = 0x4853454d;  // "MESH"
+
+	unsigned int Magic = MagicValue;
+	unsigned int VertexSize = 0;
+	unsigned int VertexCount = 0;
+	unsigned int IndexCount = 0;
+};
+
+struct MeshData
+{
+	unsigned int VertexSize = 0;
+	std::vector<unsigned char> Vertices;  // VertexSize bytes per vertex
+	std::vector<unsigned int> Indices;
+};
+
+bool LoadMeshFile(const std::string& filepath, MeshData& mesh);
+bool SaveMeshFile(const std::string& filepath, const MeshData& mesh);
+
+// Loads inputPath, runs OptimizeMesh on it and writes the result to outputPath (which may be the same file)
+bool OptimizeMeshFile(const std::string& inputPath, const std::string& outputPath, MeshOptimizationStats* stats = nullptr);
@@ -0,0 +1,178 @@
+#include "ParticleSystem.h"
+
+#include "JobPool.h"
+#include "Renderer2D.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PARTICLE_SYSTEM_SSE
+#include <xmmintrin.h>
+#endif
+
+ParticleSystem::ParticleSystem(unsigned int maxParticles)
+	: m_MaxParticles(maxParticles), m_Count(0), m_Gravity(0.0f, -98.0f), m_WorkerCount(1), m_RandomState(0x12345678)
+{
+	// The SIMD loop may run past m_Count up to the next multiple of 4
+	for (auto& array : m_Arrays)
+		array.resize((maxParticles + 3) & ~3u, 0.0f);
+}
+
+ParticleSystem::~ParticleSystem()
+{
+}
+
+void ParticleSystem::Emit(const ParticleProps& props, unsigned int count)
+{
+	const float invLifeTime = 1.0f / props.LifeTime;
+	const glm::vec4 colorDelta = (props.ColorEnd - props.ColorBegin) * invLifeTime;
+	const float sizeDelta = (props.SizeEnd - props.SizeBegin) * invLifeTime;
+
+	for (unsigned int n = 0; n < count && m_Count < m_MaxParticles; ++n)
+	{
+		const unsigned int i = m_Count++;
+
+		// xorshift32, cheap enough to emit thousands of particles per frame
+		float random[2];
+		for (float& r : random)
+		{
+			m_RandomState ^= m_RandomState << 13;
+			m_RandomState ^= m_RandomState >> 17;
+			m_RandomState ^= m_RandomState << 5;
+			r = (m_RandomState & 0xffffff) / (float)0xffffff * 2.0f - 1.0f;
+		}
+
+		m_Arrays[PositionX][i] = props.Position.x - props.SizeBegin * 0.5f;
+		m_Arrays[PositionY][i] = props.Position.y - props.SizeBegin * 0.5f;
+		m_Arrays[VelocityX][i] = props.Velocity.x + props.VelocityVariation.x * random[0];
+		m_Arrays[VelocityY][i] = props.Velocity.y + props.VelocityVariation.y * random[1];
+		m_Arrays[ColorR][i] = props.ColorBegin.r;
+		m_Arrays[ColorG][i] = props.ColorBegin.g;
+		m_Arrays[ColorB][i] = props.ColorBegin.b;
+		m_Arrays[ColorA][i] = props.ColorBegin.a;
+		m_Arrays[ColorRDelta][i] = colorDelta.r;
+		m_Arrays[ColorGDelta][i] = colorDelta.g;
+		m_Arrays[ColorBDelta][i] = colorDelta.b;
+		m_Arrays[ColorADelta][i] = colorDelta.a;
+		m_Arrays[Size][i] = props.SizeBegin;
+		m_Arrays[SizeDelta][i] = sizeDelta;
+		m_Arrays[Life][i] = props.LifeTime;
+	}
+}
+
+void ParticleSystem::Update(float deltaTime)
+{
+	const unsigned int workers = m_WorkerCount;
+	if (workers <= 1 || m_Count < 4096)
+	{
+		Integrate(0, m_Count, deltaTime);
+	}
+	else
+	{
+		// Contiguous chunks, multiples of 4 so that no SIMD group is shared by two threads
+		const unsigned int chunk = ((m_Count + workers - 1) / workers + 3) & ~3u;
+		const unsigned int chunkCount = (m_Count + chunk - 1) / chunk;
+		JobPool::Get().Run(chunkCount, [&](unsigned int i)
+		{
+			const unsigned int first = i * chunk;
+			Integrate(first, first + chunk < m_Count ? first + chunk : m_Count, deltaTime);
+		});
+	}
+
+	RemoveDead();
+}
+
+#ifdef PARTICLE_SYSTEM_SSE
+
+void ParticleSystem::Integrate(unsigned int first, unsigned int end, float deltaTime)
+{
+	const __m128 dt = _mm_set1_ps(deltaTime);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 gravityX = _mm_set1_ps(m_Gravity.x * deltaTime);
+	const __m128 gravityY = _mm_set1_ps(m_Gravity.y * deltaTime);
+
+	float* const a[AttributeCount] = {
+		m_Arrays[0].data(), m_Arrays[1].data(), m_Arrays[2].data(), m_Arrays[3].data(), m_Arrays[4].data(),
+		m_Arrays[5].data(), m_Arrays[6].data(), m_Arrays[7].data(), m_Arrays[8].data(), m_Arrays[9].data(),
+		m_Arrays[10].data(), m_Arrays[11].data(), m_Arrays[12].data(), m_Arrays[13].data(), m_Arrays[14].data()
+	};
+
+	// The padding past m_Count is updated too, it is never read back
+	for (unsigned int i = first; i < end; i += 4)
+	{
+		const __m128 sizeDelta = _mm_mul_ps(_mm_loadu_ps(a[SizeDelta] + i), dt);
+
+		// Keep the quad centered while it grows or shrinks: the corner moves by half the size change
+		__m128 vx = _mm_loadu_ps(a[VelocityX] + i);
+		__m128 vy = _mm_loadu_ps(a[VelocityY] + i);
+		_mm_storeu_ps(a[PositionX] + i, _mm_add_ps(_mm_loadu_ps(a[PositionX] + i), _mm_sub_ps(_mm_mul_ps(vx, dt), _mm_mul_ps(sizeDelta, half))));
+		_mm_storeu_ps(a[PositionY] + i, _mm_add_ps(_mm_loadu_ps(a[PositionY] + i), _mm_sub_ps(_mm_mul_ps(vy, dt), _mm_mul_ps(sizeDelta, half))));
+		_mm_storeu_ps(a[VelocityX] + i, _mm_add_ps(vx, gravityX));
+		_mm_storeu_ps(a[VelocityY] + i, _mm_add_ps(vy, gravityY));
+
+		for (int c = 0; c < 4; ++c)
+		{
+			float* color = a[ColorR + c] + i;
+			_mm_storeu_ps(color, _mm_add_ps(_mm_loadu_ps(color), _mm_mul_ps(_mm_loadu_ps(a[ColorRDelta + c] + i), dt)));
+		}
+
+		_mm_storeu_ps(a[Size] + i, _mm_add_ps(_mm_loadu_ps(a[Size] + i), sizeDelta));
+		_mm_storeu_ps(a[Life] + i, _mm_sub_ps(_mm_loadu_ps(a[Life] + i), dt));
+	}
+}
+
+#else
+
+void ParticleSystem::Integrate(unsigned int first, unsigned int end, float deltaTime)
+{
+	for (unsigned int i = first; i < end; ++i)
+	{
+		const float sizeDelta = m_Arrays[SizeDelta][i] * deltaTime;
+		m_Arrays[PositionX][i] += m_Arrays[VelocityX][i] * deltaTime - sizeDelta * 0.5f;
+		m_Arrays[PositionY][i] += m_Arrays[VelocityY][i] * deltaTime - sizeDelta * 0.5f;
+		m_Arrays[VelocityX][i] += m_Gravity.x * deltaTime;
+		m_Arrays[VelocityY][i] += m_Gravity.y * deltaTime;
+		for (int c = 0; c < 4; ++c)
+			m_Arrays[ColorR + c][i] += m_Arrays[ColorRDelta + c][i] * deltaTime;
+		m_Arrays[Size][i] += sizeDelta;
+		m_Arrays[Life][i] -= deltaTime;
+	}
+}
+
+#endif
+
+void ParticleSystem::RemoveDead()
+{
+	// Swap-remove: the last live particle takes the slot, which is checked again
+	float* life = m_Arrays[Life].data();
+	unsigned int i = 0;
+	while (i < m_Count)
+	{
+		if (life[i] > 0.0f)
+		{
+			i++;
+			continue;
+		}
+
+		const unsigned int last = --m_Count;
+		for (auto& array : m_Arrays)
+			array[i] = array[last];
+	}
+}
+
+void ParticleSystem::Render(Renderer2D& renderer) const
+{
+	QuadSpriteData sprites;
+	sprites.PositionX = m_Arrays[PositionX].data();
+	sprites.PositionY = m_Arrays[PositionY].data();
+	sprites.Width = m_Arrays[Size].data();
+	sprites.Height = m_Arrays[Size].data();
+	sprites.ColorR = m_Arrays[ColorR].data();
+	sprites.ColorG = m_Arrays[ColorG].data();
+	sprites.ColorB = m_Arrays[ColorB].data();
+	sprites.ColorA = m_Arrays[ColorA].data();
+	renderer.DrawQuads(sprites, m_Count);
+}
+
+void ParticleSystem::Clear()
+{
+	m_Count = 0;
+}
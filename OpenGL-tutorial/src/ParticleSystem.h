@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+
+#include "glm/glm.hpp"
+
+class Renderer2D;
+
+struct ParticleProps
+{
+	glm::vec2 Position = glm::vec2(0.0f);
+	glm::vec2 Velocity = glm::vec2(0.0f);
+	glm::vec2 VelocityVariation = glm::vec2(0.0f);  // random offset in [-v, v] per axis
+	glm::vec4 ColorBegin = glm::vec4(1.0f);
+	glm::vec4 ColorEnd = glm::vec4(1.0f);
+	float SizeBegin = 4.0f;
+	float SizeEnd = 0.0f;
+	float LifeTime = 1.0f;  // seconds
+};
+
+// Particles stored as structure-of-arrays, updated 4 at a time with SSE. Dead particles are
+// recycled by moving the last live one into their place, so live particles stay packed
+// at the front of the arrays and go straight to Renderer2D::DrawQuads.
+class ParticleSystem
+{
+public:
+	ParticleSystem(unsigned int maxParticles);
+	~ParticleSystem();
+
+	// Particles beyond the capacity are dropped
+	void Emit(const ParticleProps& props, unsigned int count = 1);
+	void Update(float deltaTime);
+	void Render(Renderer2D& renderer) const;
+	void Clear();
+
+	// 0 or 1: Update runs on the calling thread. More: the integration is split in as many jobs
+	// for the shared JobPool, whose threads persist between frames.
+	inline void SetWorkerCount(unsigned int count) { m_WorkerCount = count; }
+	inline unsigned int GetWorkerCount() const { return m_WorkerCount; }
+	inline void SetGravity(const glm::vec2& gravity) { m_Gravity = gravity; }
+
+	inline unsigned int GetCount() const { return m_Count; }
+	inline unsigned int GetMaxParticles() const { return m_MaxParticles; }
+
+private:
+	void Integrate(unsigned int first, unsigned int end, float deltaTime);
+	void RemoveDead();
+
+	enum Attribute
+	{
+		PositionX, PositionY,  // bottom left corner of the quad
+		VelocityX, VelocityY,
+		ColorR, ColorG, ColorB, ColorA,
+		ColorRDelta, ColorGDelta, ColorBDelta, ColorADelta,  // per second, so the color reaches ColorEnd at death
+		Size, SizeDelta,
+		Life,  // seconds left
+		AttributeCount
+	};
+
+	unsigned int m_MaxParticles;
+	unsigned int m_Count;
+	std::vector<float> m_Arrays[AttributeCount];  // padded to a multiple of 4
+
+	glm::vec2 m_Gravity;
+	unsigned int m_WorkerCount;
+	unsigned int m_RandomState;
+};
@@ -0,0 +1,139 @@
+#include "QuadCulling.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define QUAD_CULLING_SSE
+#include <xmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+unsigned int CullQuadsScalar(const QuadSpriteData& sprites, unsigned int first, unsigned int count, const CullRect& rect, unsigned int* visible)
+{
+	unsigned int n = 0;
+	for (unsigned int i = first; i < first + count; ++i)
+	{
+		const float x0 = sprites.PositionX[i];
+		const float y0 = sprites.PositionY[i];
+		const float x1 = x0 + sprites.Width[i];
+		const float y1 = y0 + sprites.Height[i];
+
+		// Branchless append: the index is always written, the count only grows when visible
+		visible[n] = i;
+		n += (x1 >= rect.MinX) & (x0 <= rect.MaxX) & (y1 >= rect.MinY) & (y0 <= rect.MaxY);
+	}
+	return n;
+}
+
+#if defined(QUAD_CULLING_SSE)
+
+// QuadCullingAVX.cpp, the only file built with AVX code generation
+unsigned int CullQuadsAVX(const QuadSpriteData& sprites, unsigned int count, const CullRect& rect, unsigned int* visible);
+
+static unsigned int CullQuadsSSE(const QuadSpriteData& sprites, unsigned int count, const CullRect& rect, unsigned int* visible)
+{
+	const __m128 minX = _mm_set1_ps(rect.MinX);
+	const __m128 minY = _mm_set1_ps(rect.MinY);
+	const __m128 maxX = _mm_set1_ps(rect.MaxX);
+	const __m128 maxY = _mm_set1_ps(rect.MaxY);
+
+	unsigned int n = 0;
+	unsigned int i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128 x0 = _mm_loadu_ps(sprites.PositionX + i);
+		const __m128 y0 = _mm_loadu_ps(sprites.PositionY + i);
+		const __m128 x1 = _mm_add_ps(x0, _mm_loadu_ps(sprites.Width + i));
+		const __m128 y1 = _mm_add_ps(y0, _mm_loadu_ps(sprites.Height + i));
+
+		__m128 inside = _mm_and_ps(_mm_cmpge_ps(x1, minX), _mm_cmple_ps(x0, maxX));
+		inside = _mm_and_ps(inside, _mm_cmpge_ps(y1, minY));
+		inside = _mm_and_ps(inside, _mm_cmple_ps(y0, maxY));
+
+		const int mask = _mm_movemask_ps(inside);
+		if (mask == 0)
+			continue;
+
+		for (int b = 0; b < 4; ++b)
+		{
+			visible[n] = i + b;
+			n += (mask >> b) & 1;
+		}
+	}
+
+	return n + CullQuadsScalar(sprites, i, count - i, rect, visible + n);
+}
+
+static bool CpuHasAVX()
+{
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 1);
+	const bool avx = (info[2] & (1 << 28)) != 0;
+	const bool osxsave = (info[2] & (1 << 27)) != 0;
+	// The OS must also save the upper halves of the YMM registers on a context switch
+	return avx && osxsave && (_xgetbv(0) & 0x6) == 0x6;
+#elif defined(__GNUC__)
+	return __builtin_cpu_supports("avx");
+#else
+	return false;
+#endif
+}
+
+bool IsQuadCullingAVX()
+{
+	static const bool avx = CpuHasAVX();
+	return avx;
+}
+
+unsigned int CullQuads(const QuadSpriteData& sprites, unsigned int count, const CullRect& rect, unsigned int* visible)
+{
+	return IsQuadCullingAVX() ? CullQuadsAVX(sprites, count, rect, visible) : CullQuadsSSE(sprites, count, rect, visible);
+}
+
+#else
+
+bool IsQuadCullingAVX()
+{
+	return false;
+}
+
+unsigned int CullQuads(const QuadSpriteData& sprites, unsigned int count, const CullRect& rect, unsigned int* visible)
+{
+	return CullQuadsScalar(sprites, 0, count, rect, visible);
+}
+
+#endif
+
+void GatherQuads(const QuadSpriteData& sprites, const unsigned int* indices, unsigned int count, QuadSpriteScratch& scratch, QuadSpriteData& out)
+{
+	const float* const sources[13] = {
+		sprites.PositionX, sprites.PositionY, sprites.Width, sprites.Height,
+		sprites.ColorR, sprites.ColorG, sprites.ColorB, sprites.ColorA,
+		sprites.U0, sprites.V0, sprites.U1, sprites.V1,
+		sprites.TexIndex
+	};
+	const float* gathered[13] = {};
+
+	for (int a = 0; a < 13; ++a)
+	{
+		if (!sources[a])
+			continue;  // optional attribute left to its default
+
+		std::vector<float>& array = scratch.Arrays[a];
+		if (array.size() < count)
+			array.resize(count);
+		for (unsigned int i = 0; i < count; ++i)
+			array[i] = sources[a][indices[i]];
+		gathered[a] = array.data();
+	}
+
+	out = sprites;
+	out.PositionX = gathered[0];  out.PositionY = gathered[1];
+	out.Width = gathered[2];      out.Height = gathered[3];
+	out.ColorR = gathered[4];     out.ColorG = gathered[5];
+	out.ColorB = gathered[6];     out.ColorA = gathered[7];
+	out.U0 = gathered[8];         out.V0 = gathered[9];
+	out.U1 = gathered[10];        out.V1 = gathered[11];
+	out.TexIndex = gathered[12];
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <vector>
+
+#include "QuadGenerator.h"
+
+// Axis aligned rectangle in world space, usually what the camera sees
+struct CullRect
+{
+	float MinX, MinY;
+	float MaxX, MaxY;
+};
+
+// Writes the indices of the sprites in [0, count) that overlap rect to visible (room for count
+// entries) and returns how many there are. Tests 8 sprites at a time with AVX, 4 with SSE;
+// the AVX kernel is picked at run time when the CPU and the OS support it.
+unsigned int CullQuads(const QuadSpriteData& sprites, unsigned int count, const CullRect& rect, unsigned int* visible);
+bool IsQuadCullingAVX();
+
+// Reference implementation, also used for the sprites left over by the SIMD loop
+unsigned int CullQuadsScalar(const QuadSpriteData& sprites, unsigned int first, unsigned int count, const CullRect& rect, unsigned int* visible);
+
+// Copies the sprites listed in indices into scratch and points out at the copies,
+// so the visible sprites can go through GenerateQuadVertices as one contiguous range.
+struct QuadSpriteScratch
+{
+	std::vector<float> Arrays[13];
+};
+void GatherQuads(const QuadSpriteData& sprites, const unsigned int* indices, unsigned int count, QuadSpriteScratch& scratch, QuadSpriteData& out);
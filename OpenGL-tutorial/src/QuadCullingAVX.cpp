@@ -0,0 +1,52 @@
+#include "QuadCulling.h"
+
+// Built with /arch:AVX (see the project file) and only called after CullQuads has checked the CPU,
+// so the rest of the program keeps running on machines without AVX
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+#include <immintrin.h>
+
+#if defined(__GNUC__) && !defined(__AVX__)
+#define QUAD_CULLING_AVX_TARGET __attribute__((target("avx")))
+#else
+#define QUAD_CULLING_AVX_TARGET
+#endif
+
+QUAD_CULLING_AVX_TARGET
+unsigned int CullQuadsAVX(const QuadSpriteData& sprites, unsigned int count, const CullRect& rect, unsigned int* visible)
+{
+	const __m256 minX = _mm256_set1_ps(rect.MinX);
+	const __m256 minY = _mm256_set1_ps(rect.MinY);
+	const __m256 maxX = _mm256_set1_ps(rect.MaxX);
+	const __m256 maxY = _mm256_set1_ps(rect.MaxY);
+
+	unsigned int n = 0;
+	unsigned int i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		const __m256 x0 = _mm256_loadu_ps(sprites.PositionX + i);
+		const __m256 y0 = _mm256_loadu_ps(sprites.PositionY + i);
+		const __m256 x1 = _mm256_add_ps(x0, _mm256_loadu_ps(sprites.Width + i));
+		const __m256 y1 = _mm256_add_ps(y0, _mm256_loadu_ps(sprites.Height + i));
+
+		__m256 inside = _mm256_and_ps(_mm256_cmp_ps(x1, minX, _CMP_GE_OQ), _mm256_cmp_ps(x0, maxX, _CMP_LE_OQ));
+		inside = _mm256_and_ps(inside, _mm256_cmp_ps(y1, minY, _CMP_GE_OQ));
+		inside = _mm256_and_ps(inside, _mm256_cmp_ps(y0, maxY, _CMP_LE_OQ));
+
+		const int mask = _mm256_movemask_ps(inside);
+		if (mask == 0)
+			continue;  // the common case in scrolling worlds: 8 sprites rejected at once
+
+		for (int b = 0; b < 8; ++b)
+		{
+			visible[n] = i + b;
+			n += (mask >> b) & 1;
+		}
+	}
+
+	// Leaves the upper YMM halves clean before the SSE code that follows
+	_mm256_zeroupper();
+	return n + CullQuadsScalar(sprites, i, count - i, rect, visible + n);
+}
+
+#endif
@@ -0,0 +1,236 @@
+#include "QuadGenerator.h"
+
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define QUAD_GENERATOR_SSE
+#include <xmmintrin.h>
+#endif
+
+static inline float Load(const float* array, unsigned int i, float defaultValue)
+{
+	return array ? array[i] : defaultValue;
+}
+
+unsigned short FloatToHalf(float value)
+{
+	unsigned int bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	const unsigned int sign = (bits >> 16) & 0x8000;
+	const int exponent = (int)((bits >> 23) & 0xff) - 127 + 15;
+	unsigned int mantissa = bits & 0x7fffff;
+
+	if (exponent <= 0)
+	{
+		// Below the smallest normal half: denormal, or zero when even that is too small
+		if (exponent < -10)
+			return (unsigned short)sign;
+		mantissa |= 0x800000;
+		const int shift = 14 - exponent;
+		unsigned int half = mantissa >> shift;
+		half += (mantissa >> (shift - 1)) & 1;
+		return (unsigned short)(sign | half);
+	}
+	if (exponent >= 31)
+	{
+		// Too large, infinity or NaN
+		const bool nan = ((bits >> 23) & 0xff) == 0xff && mantissa != 0;
+		return (unsigned short)(sign | 0x7c00 | (nan ? 0x200 : 0));
+	}
+
+	// A carry out of the mantissa bumps the exponent, which is the correct rounding
+	unsigned int half = sign | (exponent << 10) | (mantissa >> 13);
+	half += (mantissa >> 12) & 1;
+	return (unsigned short)half;
+}
+
+static unsigned int PackSnorm(float value, unsigned int bits)
+{
+	const float scale = (float)((1 << (bits - 1)) - 1);
+	value = value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value);
+	const int quantized = (int)floorf(value * scale + 0.5f);
+	return (unsigned int)quantized & ((1u << bits) - 1);  // two's complement in the field
+}
+
+unsigned int PackSnorm1010102(float x, float y, float z, float w)
+{
+	return PackSnorm(x, 10) | (PackSnorm(y, 10) << 10) | (PackSnorm(z, 10) << 20) | (PackSnorm(w, 2) << 30);
+}
+
+static inline unsigned char ToUnorm8(float value)
+{
+	value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+	return (unsigned char)(value * 255.0f + 0.5f);
+}
+
+void GeneratePackedQuadVertices(const QuadSpriteData& sprites, unsigned int first, unsigned int count, PackedQuadVertex* out)
+{
+	for (unsigned int i = first; i < first + count; ++i)
+	{
+		const float x0 = sprites.PositionX[i];
+		const float y0 = sprites.PositionY[i];
+		const float x1 = x0 + sprites.Width[i];
+		const float y1 = y0 + sprites.Height[i];
+
+		// Conversions are done once per sprite, the 4 corners only shuffle them
+		const unsigned char color[4] = {
+			ToUnorm8(Load(sprites.ColorR, i, sprites.DefaultColor[0])),
+			ToUnorm8(Load(sprites.ColorG, i, sprites.DefaultColor[1])),
+			ToUnorm8(Load(sprites.ColorB, i, sprites.DefaultColor[2])),
+			ToUnorm8(Load(sprites.ColorA, i, sprites.DefaultColor[3]))
+		};
+
+		const unsigned short u0 = FloatToHalf(Load(sprites.U0, i, 0.0f));
+		const unsigned short v0 = FloatToHalf(Load(sprites.V0, i, 0.0f));
+		const unsigned short u1 = FloatToHalf(Load(sprites.U1, i, 1.0f));
+		const unsigned short v1 = FloatToHalf(Load(sprites.V1, i, 1.0f));
+
+		const unsigned char texIndex = (unsigned char)Load(sprites.TexIndex, i, sprites.DefaultTexIndex);
+
+		const float corners[4][2] = { { x0, y0 }, { x1, y0 }, { x1, y1 }, { x0, y1 } };
+		const unsigned short texCoords[4][2] = { { u0, v0 }, { u1, v0 }, { u1, v1 }, { u0, v1 } };
+
+		for (int c = 0; c < 4; ++c)
+		{
+			out->Position[0] = corners[c][0];
+			out->Position[1] = corners[c][1];
+			memcpy(out->Color, color, sizeof(color));
+			out->TexCoords[0] = texCoords[c][0];
+			out->TexCoords[1] = texCoords[c][1];
+			out->TexID = texIndex;
+			out->Padding[0] = out->Padding[1] = out->Padding[2] = 0;
+			out++;
+		}
+	}
+}
+
+void GenerateQuadVerticesScalar(const QuadSpriteData& sprites, unsigned int first, unsigned int count, QuadVertex* out)
+{
+	for (unsigned int i = first; i < first + count; ++i)
+	{
+		const float x0 = sprites.PositionX[i];
+		const float y0 = sprites.PositionY[i];
+		const float x1 = x0 + sprites.Width[i];
+		const float y1 = y0 + sprites.Height[i];
+
+		const float r = Load(sprites.ColorR, i, sprites.DefaultColor[0]);
+		const float g = Load(sprites.ColorG, i, sprites.DefaultColor[1]);
+		const float b = Load(sprites.ColorB, i, sprites.DefaultColor[2]);
+		const float a = Load(sprites.ColorA, i, sprites.DefaultColor[3]);
+
+		const float u0 = Load(sprites.U0, i, 0.0f);
+		const float v0 = Load(sprites.V0, i, 0.0f);
+		const float u1 = Load(sprites.U1, i, 1.0f);
+		const float v1 = Load(sprites.V1, i, 1.0f);
+
+		const float texIndex = Load(sprites.TexIndex, i, sprites.DefaultTexIndex);
+
+		const float corners[4][4] = {  // x y u v, counter-clockwise from the bottom left
+			{ x0, y0, u0, v0 },
+			{ x1, y0, u1, v0 },
+			{ x1, y1, u1, v1 },
+			{ x0, y1, u0, v1 }
+		};
+
+		for (int c = 0; c < 4; ++c)
+		{
+			out->Position[0] = corners[c][0];
+			out->Position[1] = corners[c][1];
+			out->Color[0] = r;
+			out->Color[1] = g;
+			out->Color[2] = b;
+			out->Color[3] = a;
+			out->TexCoords[0] = corners[c][2];
+			out->TexCoords[1] = corners[c][3];
+			out->TexID = texIndex;
+			out++;
+		}
+	}
+}
+
+#ifdef QUAD_GENERATOR_SSE
+
+static inline __m128 Load4(const float* array, unsigned int i, float defaultValue)
+{
+	return array ? _mm_loadu_ps(array + i) : _mm_set1_ps(defaultValue);
+}
+
+// A vertex is 9 floats: [x y r g] [b a u v] [t]. Both 4-float halves are
+// assembled in registers so each vertex costs two unaligned stores and a scalar one.
+static inline void StoreVertex(float* out, __m128 position, __m128 color, __m128 texCoords, __m128 texIndex)
+{
+	_mm_storeu_ps(out, _mm_movelh_ps(position, color));
+	_mm_storeu_ps(out + 4, _mm_shuffle_ps(color, texCoords, _MM_SHUFFLE(1, 0, 3, 2)));
+	_mm_store_ss(out + 8, texIndex);
+}
+
+void GenerateQuadVertices(const QuadSpriteData& sprites, unsigned int first, unsigned int count, QuadVertex* out)
+{
+	static_assert(sizeof(QuadVertex) == 9 * sizeof(float), "the SSE kernel writes QuadVertex as 9 packed floats");
+
+	const unsigned int end = first + count;
+	unsigned int i = first;
+	float* dst = (float*)out;
+
+	for (; i + 4 <= end; i += 4)
+	{
+		// Load 4 sprites, one attribute per register
+		__m128 x0 = Load4(sprites.PositionX, i, 0.0f);
+		__m128 y0 = Load4(sprites.PositionY, i, 0.0f);
+		__m128 x1 = _mm_add_ps(x0, _mm_loadu_ps(sprites.Width + i));
+		__m128 y1 = _mm_add_ps(y0, _mm_loadu_ps(sprites.Height + i));
+
+		__m128 r = Load4(sprites.ColorR, i, sprites.DefaultColor[0]);
+		__m128 g = Load4(sprites.ColorG, i, sprites.DefaultColor[1]);
+		__m128 b = Load4(sprites.ColorB, i, sprites.DefaultColor[2]);
+		__m128 a = Load4(sprites.ColorA, i, sprites.DefaultColor[3]);
+
+		__m128 u0 = Load4(sprites.U0, i, 0.0f);
+		__m128 v0 = Load4(sprites.V0, i, 0.0f);
+		__m128 u1 = Load4(sprites.U1, i, 1.0f);
+		__m128 v1 = Load4(sprites.V1, i, 1.0f);
+
+		__m128 t = Load4(sprites.TexIndex, i, sprites.DefaultTexIndex);
+
+		// Transpose so that each register holds one sprite: (x0 y0 x1 y1), (r g b a), (u0 v0 u1 v1)
+		_MM_TRANSPOSE4_PS(x0, y0, x1, y1);
+		_MM_TRANSPOSE4_PS(r, g, b, a);
+		_MM_TRANSPOSE4_PS(u0, v0, u1, v1);
+
+		const __m128 rects[4] = { x0, y0, x1, y1 };
+		const __m128 colors[4] = { r, g, b, a };
+		const __m128 uvs[4] = { u0, v0, u1, v1 };
+		const __m128 texIndices[4] = {
+			t,
+			_mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1)),
+			_mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 2, 2)),
+			_mm_shuffle_ps(t, t, _MM_SHUFFLE(3, 3, 3, 3))
+		};
+
+		for (int s = 0; s < 4; ++s)
+		{
+			const __m128 p = rects[s];
+			const __m128 uv = uvs[s];
+
+			// Corner k takes lanes (0,1), (2,1), (2,3), (0,3) of the rect, same for the UVs
+			StoreVertex(dst +  0, p, colors[s], uv, texIndices[s]);
+			StoreVertex(dst +  9, _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 1, 2)), colors[s], _mm_shuffle_ps(uv, uv, _MM_SHUFFLE(3, 3, 1, 2)), texIndices[s]);
+			StoreVertex(dst + 18, _mm_movehl_ps(p, p), colors[s], _mm_movehl_ps(uv, uv), texIndices[s]);
+			StoreVertex(dst + 27, _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 3, 0)), colors[s], _mm_shuffle_ps(uv, uv, _MM_SHUFFLE(3, 3, 3, 0)), texIndices[s]);
+			dst += 36;
+		}
+	}
+
+	GenerateQuadVerticesScalar(sprites, i, end - i, (QuadVertex*)dst);
+}
+
+#else
+
+void GenerateQuadVertices(const QuadSpriteData& sprites, unsigned int first, unsigned int count, QuadVertex* out)
+{
+	GenerateQuadVerticesScalar(sprites, first, count, out);
+}
+
+#endif
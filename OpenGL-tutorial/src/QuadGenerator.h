@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+
+struct QuadVertex
+{
+	float Position[2];
+	float Color[4];
+	float TexCoords[2];
+	float TexID;
+};
+
+// 20 bytes instead of 36, for when vertex bandwidth is the limit.
+// Fields in the order of Renderer2D::CreateVertexLayout(Packed).
+struct PackedQuadVertex
+{
+	float Position[2];
+	unsigned char Color[4];       // RGBA8, normalized by the attribute
+	unsigned short TexCoords[2];  // half floats
+	unsigned char TexID;          // integer attribute
+	unsigned char Padding[3];     // keeps the vertex 4-byte aligned
+};
+// The stride matches with the two middle attributes swapped, only the offsets catch that
+static_assert(offsetof(PackedQuadVertex, Color) == 8 && offsetof(PackedQuadVertex, TexCoords) == 12, "PackedQuadVertex no longer matches its vertex layout");
+
+// Vertex of an analytic shape (circle, ring, rounded rect) evaluated by the fragment shader
+struct ShapeVertex
+{
+	float Position[2];
+	float Local[2];            // position in the shape's frame, in world units from its center
+	float Params[4];           // shape parameters, see Renderer2D::DrawShape
+	unsigned char Color[4];    // RGBA8
+	unsigned char Shape;       // Renderer2D::Shape
+	unsigned char Padding[3];
+};
+
+// IEEE 754 binary16 bits of value, rounded to nearest
+unsigned short FloatToHalf(float value);
+
+// Signed normalized x, y, z (10 bits) and w (2 bits) in the GL_INT_2_10_10_10_REV layout, x in the low bits.
+// Read back with VertexBufferLayout::PushPacked(true, true); components are clamped to [-1, 1].
+unsigned int PackSnorm1010102(float x, float y, float z, float w);
+
+// Structure-of-arrays description of a list of axis aligned sprites.
+// Position, Width and Height are required; any other array left as nullptr
+// takes its default (DefaultColor, full 0..1 UV rect, texture slot DefaultTexIndex).
+struct QuadSpriteData
+{
+	const float* PositionX = nullptr;  // bottom left corner
+	const float* PositionY = nullptr;
+	const float* Width = nullptr;
+	const float* Height = nullptr;
+
+	const float* ColorR = nullptr;
+	const float* ColorG = nullptr;
+	const float* ColorB = nullptr;
+	const float* ColorA = nullptr;
+
+	const float* U0 = nullptr;  // UV rect: (U0, V0) bottom left, (U1, V1) top right
+	const float* V0 = nullptr;
+	const float* U1 = nullptr;
+	const float* V1 = nullptr;
+
+	const float* TexIndex = nullptr;
+	float DefaultTexIndex = 0.0f;
+	float DefaultColor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+};
+
+// Writes 4 interleaved vertices per sprite for the sprites [first, first + count) into out.
+// Uses SSE when the compiler targets it, otherwise the scalar version.
+void GenerateQuadVertices(const QuadSpriteData& sprites, unsigned int first, unsigned int count, QuadVertex* out);
+
+// Reference implementation, also used for the sprites left over by the SIMD loop.
+void GenerateQuadVerticesScalar(const QuadSpriteData& sprites, unsigned int first, unsigned int count, QuadVertex* out);
+
+// Same as GenerateQuadVertices for the packed vertex format. Colors are clamped to [0, 1].
+void GeneratePackedQuadVertices(const QuadSpriteData& sprites, unsigned int first, unsigned int count, PackedQuadVertex* out);
@@ -0,0 +1,205 @@
+#include "RenderQueue.h"
+
+#include "Renderer.h"
+
+// Hashed by the compiler, each shader change then costs one lookup
+static constexpr UniformID ModelUniform("u_Model");
+
+RenderQueue::RenderQueue()
+	: m_View(1.0f), m_Projection(1.0f), m_SortingEnabled(true)
+{
+}
+
+RenderQueue::~RenderQueue()
+{
+}
+
+void RenderQueue::Begin(const glm::mat4& view, const glm::mat4& projection)
+{
+	m_View = view;
+	m_Projection = projection;
+	m_Commands.clear();
+	m_Entries.clear();
+	m_Stats = Statistics();
+}
+
+void RenderQueue::Submit(const RenderCommand& command)
+{
+	m_Entries.push_back({ MakeSortKey(command), (unsigned int)m_Commands.size() });
+	m_Commands.push_back(command);
+}
+
+void RenderQueue::End()
+{
+	if (m_SortingEnabled)
+		Sort();
+	Execute();
+}
+
+uint64_t RenderQueue::MakeSortKey(const RenderCommand& command)
+{
+	// Ids are folded into their field; a collision only costs an extra state change,
+	// Execute compares the real objects.
+	uint64_t textures = 0;
+	for (unsigned int i = 0; i < RenderCommand::MaxTextures; ++i)
+	{
+		if (command.Textures[i])
+			textures = textures * 31 + command.Textures[i]->GetRendererID();
+	}
+	textures = (textures ^ (textures >> 16) ^ (textures >> 32)) & 0xffff;
+
+	float depth = command.Depth < 0.0f ? 0.0f : (command.Depth > 1.0f ? 1.0f : command.Depth);
+	uint64_t depthBits = (uint64_t)(depth * 65535.0f);
+	const uint64_t material = ((uint64_t)(command.Program->GetRendererID() & 0x3fff) << 24) |
+		(textures << 8) | (command.VAO->GetRendererID() & 0xff);
+
+	uint64_t key = 0;
+	key |= (uint64_t)command.Layer << 56;
+	key |= (uint64_t)((unsigned int)command.Blend & 0x3) << 54;
+	if (command.Blend == BlendMode::Opaque)
+	{
+		// Opaque commands are grouped by state, depth only orders draws that share it
+		key |= material << 16;
+		key |= depthBits;
+	}
+	else
+	{
+		// Blended commands are drawn back to front, so depth goes above the state fields
+		key |= (0xffff - depthBits) << 38;
+		key |= material;
+	}
+	return key;
+}
+
+void RenderQueue::Sort()
+{
+	// LSD radix sort on the key, 8 bits per pass. The histograms of all 8 bytes
+	// are built in a single pass and bytes where every key agrees are skipped.
+	const size_t count = m_Entries.size();
+	if (count < 2)
+		return;
+
+	unsigned int histograms[8][256] = {};
+	for (const SortEntry& entry : m_Entries)
+	{
+		for (int byte = 0; byte < 8; ++byte)
+			histograms[byte][(entry.Key >> (byte * 8)) & 0xff]++;
+	}
+
+	m_Scratch.resize(count);
+	SortEntry* src = m_Entries.data();
+	SortEntry* dst = m_Scratch.data();
+
+	for (int byte = 0; byte < 8; ++byte)
+	{
+		unsigned int* histogram = histograms[byte];
+		if (histogram[(src[0].Key >> (byte * 8)) & 0xff] == count)
+			continue;
+
+		unsigned int offset = 0;
+		for (int i = 0; i < 256; ++i)
+		{
+			unsigned int n = histogram[i];
+			histogram[i] = offset;
+			offset += n;
+		}
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			unsigned int bucket = (src[i].Key >> (byte * 8)) & 0xff;
+			dst[histogram[bucket]++] = src[i];
+		}
+
+		std::swap(src, dst);
+	}
+
+	if (src != m_Entries.data())
+		m_Entries.swap(m_Scratch);
+}
+
+static void SetBlendMode(BlendMode blend)
+{
+	switch (blend)
+	{
+	case BlendMode::Opaque:
+		GLStateCache::SetBlendEnabled(false);
+		break;
+	case BlendMode::Alpha:
+		GLStateCache::SetBlendEnabled(true);
+		GLStateCache::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		break;
+	case BlendMode::Additive:
+		GLStateCache::SetBlendEnabled(true);
+		GLStateCache::SetBlendFunc(GL_SRC_ALPHA, GL_ONE);
+		break;
+	}
+}
+
+void RenderQueue::Execute()
+{
+	const Shader* currentShader = nullptr;
+	const VertexArray* currentVAO = nullptr;
+	const IndexBuffer* currentIB = nullptr;
+	const Texture* currentTextures[RenderCommand::MaxTextures] = {};
+	bool blendSet = false;
+	BlendMode currentBlend = BlendMode::Alpha;
+	UniformHandle modelUniform;  // of currentShader, looked up once per shader change
+
+	// One camera upload for the whole queue, each command only sets its model matrix
+	Renderer::SetCamera(m_View, m_Projection);
+
+	for (const SortEntry& entry : m_Entries)
+	{
+		const RenderCommand& command = m_Commands[entry.Index];
+
+		if (command.Program != currentShader)
+		{
+			command.Program->Bind();
+			currentShader = command.Program;
+			modelUniform = command.Program->GetUniformHandle(ModelUniform);
+			m_Stats.ShaderChanges++;
+		}
+
+		if (command.VAO != currentVAO)
+		{
+			command.VAO->Bind();
+			currentVAO = command.VAO;
+			currentIB = nullptr;  // the element buffer binding is part of the vertex array state
+			m_Stats.VertexArrayChanges++;
+		}
+
+		if (command.IB != currentIB)
+		{
+			command.IB->Bind();
+			currentIB = command.IB;
+		}
+
+		for (unsigned int i = 0; i < RenderCommand::MaxTextures; ++i)
+		{
+			if (command.Textures[i] && command.Textures[i] != currentTextures[i])
+			{
+				command.Textures[i]->Bind(i);
+				currentTextures[i] = command.Textures[i];
+				m_Stats.TextureChanges++;
+			}
+		}
+
+		if (!blendSet || command.Blend != currentBlend)
+		{
+			SetBlendMode(command.Blend);
+			currentBlend = command.Blend;
+			blendSet = true;
+			m_Stats.BlendChanges++;
+		}
+
+		command.Program->SetUniformMat4f(modelUniform, command.Transform);
+
+		unsigned int indexCount = command.IndexCount ? command.IndexCount : command.IB->GetCount();
+		GLCall(glDrawElements(GL_TRIANGLES, indexCount, command.IB->GetType(), nullptr));
+		m_Stats.DrawCalls++;
+	}
+
+	// Leave the blending the rest of the application expects
+	if (blendSet && currentBlend != BlendMode::Alpha)
+		SetBlendMode(BlendMode::Alpha);
+}
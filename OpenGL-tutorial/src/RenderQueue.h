@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "VertexArray.h"
+#include "IndexBuffer.h"
+#include "Shader.h"
+#include "Texture.h"
+
+enum class BlendMode : unsigned char
+{
+	Opaque = 0, Alpha = 1, Additive = 2
+};
+
+struct RenderCommand
+{
+	static const unsigned int MaxTextures = 4;
+
+	const VertexArray* VAO = nullptr;
+	const IndexBuffer* IB = nullptr;
+	Shader* Program = nullptr;  // must read the Camera block and have a u_Model uniform
+	const Texture* Textures[MaxTextures] = {};  // Textures[i] is bound to unit i
+	unsigned int IndexCount = 0;  // 0 draws the whole index buffer
+
+	glm::mat4 Transform = glm::mat4(1.0f);  // model matrix, u_Model
+	unsigned char Layer = 0;  // lower layers are drawn first
+	BlendMode Blend = BlendMode::Alpha;
+	float Depth = 0.0f;  // 0..1, larger is farther; blended commands are drawn farthest first
+};
+
+// Records draw commands during a frame and submits them sorted by a 64-bit key,
+// so that commands sharing a program, textures and vertex array are drawn together.
+// Commands in the same layer must not depend on their submission order.
+class RenderQueue
+{
+public:
+	struct Statistics
+	{
+		unsigned int DrawCalls = 0;
+		unsigned int ShaderChanges = 0;
+		unsigned int TextureChanges = 0;
+		unsigned int VertexArrayChanges = 0;
+		unsigned int BlendChanges = 0;
+	};
+
+	RenderQueue();
+	~RenderQueue();
+
+	void Begin(const glm::mat4& view, const glm::mat4& projection);
+	void Submit(const RenderCommand& command);
+	void End();  // sorts and executes every command submitted since Begin
+
+	inline void SetSortingEnabled(bool enabled) { m_SortingEnabled = enabled; }
+	inline const Statistics& GetStats() const { return m_Stats; }
+
+	// Bits, most significant first:
+	//   opaque:  layer 8 | blend 2 | shader 14 | textures 16 | vertex array 8 | depth 16
+	//   blended: layer 8 | blend 2 | inverted depth 16 | shader 14 | textures 16 | vertex array 8
+	static uint64_t MakeSortKey(const RenderCommand& command);
+
+private:
+	struct SortEntry
+	{
+		uint64_t Key;
+		unsigned int Index;
+	};
+
+	void Sort();
+	void Execute();
+
+	std::vector<RenderCommand> m_Commands;
+	std::vector<SortEntry> m_Entries;
+	std::vector<SortEntry> m_Scratch;  // radix sort ping-pong buffer
+
+	glm::mat4 m_View;
+	glm::mat4 m_Projection;
+	bool m_SortingEnabled;
+	Statistics m_Stats;
+};
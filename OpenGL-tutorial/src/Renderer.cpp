@@ -1,6 +1,7 @@
 #include "Renderer.h"
 
 #include <iostream>
+#include <memory>
 
 void GLClearError()
 {
@@ -18,15 +19,122 @@ bool GLLogCall(const char* function, const char* file, int line)
 	return true;
 }
 
+static RendererCapabilities QueryCapabilities()
+{
+	RendererCapabilities caps;
+	GLCall(glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &caps.MaxTextureUnits));
+	caps.BufferStorage = GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+	caps.BaseInstance = GLEW_VERSION_4_2 || GLEW_ARB_base_instance;
+	caps.MultiDrawIndirect = GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect;
+	caps.ComputeShaders = GLEW_VERSION_4_3 || (GLEW_ARB_compute_shader && GLEW_ARB_shader_storage_buffer_object);
+	caps.DirectStateAccess = GLEW_VERSION_4_5 || GLEW_ARB_direct_state_access;
+	return caps;
+}
+
+const RendererCapabilities& Renderer::GetCapabilities()
+{
+	static RendererCapabilities s_Capabilities = QueryCapabilities();
+	return s_Capabilities;
+}
+
+static std::unique_ptr<UniformBuffer> s_CameraBuffer;
+
+void Renderer::Init()
+{
+	s_CameraBuffer = std::make_unique<UniformBuffer>((unsigned int)sizeof(CameraUniforms), (unsigned int)UniformBinding::Camera);
+	SetCamera(glm::mat4(1.0f), glm::mat4(1.0f));
+}
+
+void Renderer::Shutdown()
+{
+	s_CameraBuffer = nullptr;
+}
+
+void Renderer::SetCamera(const glm::mat4& view, const glm::mat4& projection)
+{
+	ASSERT(s_CameraBuffer);
+
+	CameraUniforms camera;
+	camera.View = view;
+	camera.Projection = projection;
+	camera.ViewProjection = projection * view;
+	s_CameraBuffer->SetData(&camera, sizeof(camera));
+}
+
 void Renderer::Clear() const
 {
 	GLCall(glClear(GL_COLOR_BUFFER_BIT));
 }
 
 void Renderer::Draw(const VertexArray & va, const IndexBuffer & ib, const Shader & shader) const
+{
+	Draw(va, ib, shader, ib.GetCount());
+}
+
+void Renderer::Draw(const VertexArray & va, const IndexBuffer & ib, const Shader & shader, unsigned int indexCount) const
+{
+	shader.Bind();
+	va.Bind();
+	ib.Bind();
+	GLCall(glDrawElements(GL_TRIANGLES, indexCount, ib.GetType(), nullptr));
+}
+
+void Renderer::Draw(const VertexArray & va, const IndexBuffer & ib, const Shader & shader, unsigned int indexCount, int baseVertex) const
+{
+	shader.Bind();
+	va.Bind();
+	ib.Bind();
+	GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, ib.GetType(), nullptr, baseVertex));
+}
+
+void Renderer::DrawInstanced(const VertexArray & va, const IndexBuffer & ib, const Shader & shader, unsigned int indexCount, unsigned int instanceCount) const
 {
 	shader.Bind();
 	va.Bind();
 	ib.Bind();
-	GLCall(glDrawElements(GL_TRIANGLES, ib.GetCount(), GL_UNSIGNED_INT, nullptr));  //unsigned int is hard-coded
+	GLCall(glDrawElementsInstanced(GL_TRIANGLES, indexCount, ib.GetType(), nullptr, instanceCount));
+}
+
+void Renderer::MultiDrawIndirect(const VertexArray & va, const IndexBuffer & ib, const Shader & shader, const DrawIndirectBuffer & commands) const
+{
+	if (!GetCapabilities().MultiDrawIndirect)
+	{
+		DrawCommands(va, ib, shader, commands);
+		return;
+	}
+
+	shader.Bind();
+	va.Bind();
+	ib.Bind();
+	commands.Bind();
+	GLCall(glMultiDrawElementsIndirect(GL_TRIANGLES, ib.GetType(), nullptr, commands.GetCount(), 0));
+	commands.Unbind();
+}
+
+void Renderer::DrawCommands(const VertexArray & va, const IndexBuffer & ib, const Shader & shader, const DrawIndirectBuffer & commands) const
+{
+	shader.Bind();
+	va.Bind();
+	ib.Bind();
+
+	const unsigned int indexSize = ib.GetType() == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+	const bool baseInstance = GetCapabilities().BaseInstance;
+	for (const DrawElementsIndirectCommand& command : commands.GetCommands())
+	{
+		const void* firstIndex = (const void*)(size_t)(command.FirstIndex * indexSize);
+		if (baseInstance)
+		{
+			GLCall(glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, command.Count, ib.GetType(), firstIndex,
+				command.InstanceCount, command.BaseVertex, command.BaseInstance));
+		}
+		else
+		{
+			// Without GL 4.2 the instance buffers are offset instead
+			va.SetBaseInstance(command.BaseInstance);
+			GLCall(glDrawElementsInstancedBaseVertex(GL_TRIANGLES, command.Count, ib.GetType(), firstIndex,
+				command.InstanceCount, command.BaseVertex));
+		}
+	}
+	if (!baseInstance)
+		va.SetBaseInstance(0);
 }
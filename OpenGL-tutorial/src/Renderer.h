@@ -4,6 +4,9 @@
 #include "IndexBuffer.h"
 #include "VertexArray.h"
 #include "Shader.h"
+#include "DrawIndirectBuffer.h"
+#include "GLStateCache.h"
+#include "UniformBuffer.h"
 
 #define ASSERT(x) if(!(x))  __debugbreak()
 #ifdef _DEBUG
@@ -17,11 +20,39 @@
 void GLClearError();
 bool GLLogCall(const char* function, const char* file, int line);
 
+// Limits reported by the driver, queried once on first use (needs a current GL context)
+struct RendererCapabilities
+{
+	int MaxTextureUnits;  // GL_MAX_TEXTURE_IMAGE_UNITS, texture units usable by a fragment shader
+	bool BufferStorage;   // GL 4.4 / ARB_buffer_storage, needed for persistently mapped buffers
+	bool BaseInstance;    // GL 4.2 / ARB_base_instance
+	bool MultiDrawIndirect;  // GL 4.3 / ARB_multi_draw_indirect
+	bool ComputeShaders;  // GL 4.3 / ARB_compute_shader with shader storage buffers
+	bool DirectStateAccess;  // GL 4.5 / ARB_direct_state_access, objects are edited without binding them
+};
+
 class Renderer
 {
 public:
+	static const RendererCapabilities& GetCapabilities();
+
+	// Creates the uniform buffers shared by every shader; call once the context exists,
+	// and Shutdown before it is destroyed
+	static void Init();
+	static void Shutdown();
+
+	// Uploads the Camera block once for every draw that follows
+	static void SetCamera(const glm::mat4& view, const glm::mat4& projection);
+
 	void Clear() const;
 	void Draw(const VertexArray & va, const IndexBuffer& ib, const Shader& shader) const;
+	void Draw(const VertexArray & va, const IndexBuffer& ib, const Shader& shader, unsigned int indexCount) const;  // draws only the first indexCount indices
+	void Draw(const VertexArray & va, const IndexBuffer& ib, const Shader& shader, unsigned int indexCount, int baseVertex) const;  // baseVertex is added to every index
+	void DrawInstanced(const VertexArray & va, const IndexBuffer& ib, const Shader& shader, unsigned int indexCount, unsigned int instanceCount) const;
+	// Every uploaded command of the buffer in one call; falls back to DrawCommands without GL 4.3,
+	// which replays the CPU copy of the commands and so misses anything the GPU wrote to them
+	void MultiDrawIndirect(const VertexArray & va, const IndexBuffer& ib, const Shader& shader, const DrawIndirectBuffer& commands) const;
+	void DrawCommands(const VertexArray & va, const IndexBuffer& ib, const Shader& shader, const DrawIndirectBuffer& commands) const;  // one draw call per command
 
 private:
 
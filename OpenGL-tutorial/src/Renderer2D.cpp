@@ -0,0 +1,619 @@
+#include "Renderer2D.h"
+
+#include "Renderer.h"
+#include "VertexBufferLayout.h"
+#include "StaticBatch.h"
+#include "Font.h"
+#include "Tilemap.h"
+
+#include <algorithm>
+#include <cmath>
+
+// The shader indexes a sampler array, keep it to a size every driver accepts
+static const unsigned int MaxSupportedTextureSlots = 32;
+
+// Shape quads are grown by this much (world units) so the antialiased edge is not clipped
+static const float ShapeEdgeMargin = 1.0f;
+
+Renderer2D::Renderer2D(unsigned int maxQuads, VertexFormat format)
+	: m_MaxQuads(maxQuads), m_MaxVertices(maxQuads * 4), m_Format(format),
+	m_VertexSize(format == VertexFormat::Packed ? sizeof(PackedQuadVertex) : sizeof(QuadVertex)), m_TextureSlotIndex(1), m_SDFSlots(0),
+	m_QuadBufferBase(nullptr), m_QuadBufferPtr(nullptr), m_QuadCount(0), m_ViewProjection(1.0f), m_FrameIndex(0),
+	m_ShapeBufferBase(nullptr), m_ShapeBufferPtr(nullptr), m_ShapeCount(0),
+	m_CullingEnabled(true), m_ViewRect{ -1.0f, -1.0f, 1.0f, 1.0f }
+{
+	m_VAO = std::make_unique<VertexArray>();
+
+	// Each flush writes a new region, the GPU keeps reading the previous ones without stalling the CPU
+	m_VertexBuffer = std::make_unique<VertexBuffer>(m_MaxVertices * m_VertexSize, BufferUsage::Streaming, 3);
+	VertexBufferLayout layout = CreateVertexLayout(m_Format);
+	ASSERT(layout.GetStride() == m_VertexSize);
+	m_VAO->AddBuffer(*m_VertexBuffer, layout);
+
+	m_IndexBuffer = IndexBuffer::GetQuadIndexBuffer(m_MaxQuads);
+
+	unsigned int white = 0xffffffff;
+	m_WhiteTexture = std::make_unique<Texture>(1, 1, &white);
+
+	m_MaxTextureSlots = Renderer::GetCapabilities().MaxTextureUnits;
+	if (m_MaxTextureSlots > MaxSupportedTextureSlots)
+		m_MaxTextureSlots = MaxSupportedTextureSlots;
+	m_TextureSlots.resize(m_MaxTextureSlots, nullptr);
+	m_TextureSlots[0] = m_WhiteTexture.get();
+
+	// The sampler array is sized to the texture units of this driver
+	std::unordered_map<std::string, std::string> defines{ { "MAX_TEXTURE_SLOTS", std::to_string(m_MaxTextureSlots) } };
+	if (m_Format == VertexFormat::Packed)
+		defines["PACKED_VERTICES"] = "1";
+	m_Shader = std::make_unique<Shader>("res/shaders/Renderer2D.shader", defines);
+	m_Shader->Bind();
+	std::vector<int> samplers(m_MaxTextureSlots);
+	for (unsigned int i = 0; i < m_MaxTextureSlots; ++i)
+		samplers[i] = i;
+	m_Shader->SetUniform1iv("u_Textures", m_MaxTextureSlots, samplers.data());
+	m_SDFSlotsUniform = m_Shader->GetUniformHandle("u_SDFSlots");
+
+	m_ShapeVAO = std::make_unique<VertexArray>();
+	m_ShapeVertexBuffer = std::make_unique<VertexBuffer>(m_MaxVertices * (unsigned int)sizeof(ShapeVertex), BufferUsage::Streaming, 3);
+	VertexBufferLayout shapeLayout;
+	shapeLayout.Push<float>(2);
+	shapeLayout.Push<float>(2);
+	shapeLayout.Push<float>(4);
+	shapeLayout.Push<unsigned char>(4);
+	shapeLayout.PushInteger(GL_UNSIGNED_BYTE, 1);
+	shapeLayout.PushPadding(3);
+	ASSERT(shapeLayout.GetStride() == sizeof(ShapeVertex));
+	m_ShapeVAO->AddBuffer(*m_ShapeVertexBuffer, shapeLayout);
+	m_ShapeShader = std::make_unique<Shader>("res/shaders/SDFShapes.shader");
+
+	StartBatch();
+	StartShapeBatch();
+}
+
+Renderer2D::~Renderer2D()
+{
+}
+
+VertexBufferLayout Renderer2D::CreateVertexLayout(VertexFormat format)
+{
+	VertexBufferLayout layout;
+	if (format == VertexFormat::Packed)
+	{
+		// Same attribute locations as the float format, the shader only changes the slot to a uint
+		layout.Push<float>(2);
+		layout.Push<unsigned char>(4);
+		layout.PushHalf(2);
+		layout.PushInteger(GL_UNSIGNED_BYTE, 1);
+		layout.PushPadding(3);
+	}
+	else
+	{
+		layout.Push<float>(2);
+		layout.Push<float>(4);
+		layout.Push<float>(2);
+		layout.Push<float>(1);
+	}
+	return layout;
+}
+
+void Renderer2D::BeginScene(const glm::mat4& viewProjection)
+{
+	m_ViewProjection = viewProjection;
+	m_FrameIndex++;
+
+	// The shaders read the camera block; the scene has no separate view
+	Renderer::SetCamera(glm::mat4(1.0f), viewProjection);
+
+	// Bring the corners of clip space back to the world, their bounds are what the camera sees
+	glm::mat4 inverse = glm::inverse(viewProjection);
+	const glm::vec2 ndc[4] = { { -1.0f, -1.0f }, { 1.0f, -1.0f }, { 1.0f, 1.0f }, { -1.0f, 1.0f } };
+	for (int i = 0; i < 4; ++i)
+	{
+		glm::vec4 corner = inverse * glm::vec4(ndc[i], 0.0f, 1.0f);
+		float x = corner.x / corner.w, y = corner.y / corner.w;
+		if (i == 0 || x < m_ViewRect.MinX) m_ViewRect.MinX = x;
+		if (i == 0 || y < m_ViewRect.MinY) m_ViewRect.MinY = y;
+		if (i == 0 || x > m_ViewRect.MaxX) m_ViewRect.MaxX = x;
+		if (i == 0 || y > m_ViewRect.MaxY) m_ViewRect.MaxY = y;
+	}
+
+	StartBatch();
+
+	// Anything may have been bound since the last scene (ImGui uses unit 0 too)
+	ResetTextureSlots();
+}
+
+void Renderer2D::EndScene()
+{
+	Flush();
+}
+
+void Renderer2D::StartBatch()
+{
+	unsigned int stalls = m_VertexBuffer->GetStallCount();
+	m_QuadBufferBase = (unsigned char*)m_VertexBuffer->BeginRegion();
+	m_Stats.BufferStalls += m_VertexBuffer->GetStallCount() - stalls;
+
+	m_QuadBufferPtr = m_QuadBufferBase;
+	m_QuadCount = 0;
+}
+
+void Renderer2D::Flush()
+{
+	// At most one of the two has pending work, see DrawShape
+	FlushQuads();
+	FlushShapes();
+}
+
+void Renderer2D::FlushQuads()
+{
+	if (m_QuadCount == 0)
+		return;
+
+	unsigned int size = (unsigned int)(m_QuadBufferPtr - m_QuadBufferBase);
+	m_VertexBuffer->EndRegion(size);
+	int baseVertex = m_VertexBuffer->GetRegionOffset() / m_VertexSize;
+
+	m_Shader->Bind();
+	m_Shader->SetUniform1i(m_SDFSlotsUniform, (int)m_SDFSlots);
+
+	Renderer renderer;
+	renderer.Draw(*m_VAO, *m_IndexBuffer, *m_Shader, m_QuadCount * 6, baseVertex);
+	m_Stats.DrawCalls++;
+
+	StartBatch();
+}
+
+void Renderer2D::StartShapeBatch()
+{
+	unsigned int stalls = m_ShapeVertexBuffer->GetStallCount();
+	m_ShapeBufferBase = (ShapeVertex*)m_ShapeVertexBuffer->BeginRegion();
+	m_Stats.BufferStalls += m_ShapeVertexBuffer->GetStallCount() - stalls;
+
+	m_ShapeBufferPtr = m_ShapeBufferBase;
+	m_ShapeCount = 0;
+}
+
+void Renderer2D::FlushShapes()
+{
+	if (m_ShapeCount == 0)
+		return;
+
+	m_ShapeVertexBuffer->EndRegion(m_ShapeCount * 4 * (unsigned int)sizeof(ShapeVertex));
+	int baseVertex = m_ShapeVertexBuffer->GetRegionOffset() / sizeof(ShapeVertex);
+
+	m_ShapeShader->Bind();
+
+	Renderer renderer;
+	renderer.Draw(*m_ShapeVAO, *m_IndexBuffer, *m_ShapeShader, m_ShapeCount * 6, baseVertex);
+	m_Stats.DrawCalls++;
+
+	StartShapeBatch();
+}
+
+void Renderer2D::ResetTextureSlots()
+{
+	for (unsigned int i = 1; i < m_TextureSlotIndex; ++i)
+		m_TextureSlots[i] = nullptr;
+	m_TextureSlotIndex = 1;
+	m_SDFSlots = 0;
+
+	m_WhiteTexture->Bind(0);
+	m_Stats.TextureBinds++;
+}
+
+float Renderer2D::GetTextureSlot(const Texture& texture)
+{
+	for (unsigned int i = 1; i < m_TextureSlotIndex; ++i)
+	{
+		if (m_TextureSlots[i] == &texture)
+			return (float)i;
+	}
+
+	// Every unit is taken by the current batch: draw it and start over with empty slots
+	if (m_TextureSlotIndex >= m_MaxTextureSlots)
+	{
+		Flush();
+		ResetTextureSlots();
+	}
+
+	// Only textures new to the batch are bound, the others stay on their unit
+	unsigned int slot = m_TextureSlotIndex++;
+	m_TextureSlots[slot] = &texture;
+	texture.Bind(slot);
+	m_Stats.TextureBinds++;
+	return (float)slot;
+}
+
+bool Renderer2D::IsVisible(const glm::vec2& position, const glm::vec2& size) const
+{
+	return !m_CullingEnabled ||
+		(position.x + size.x >= m_ViewRect.MinX && position.x <= m_ViewRect.MaxX &&
+		 position.y + size.y >= m_ViewRect.MinY && position.y <= m_ViewRect.MaxY);
+}
+
+void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color)
+{
+	if (!IsVisible(position, size))
+	{
+		m_Stats.CulledQuads++;
+		return;
+	}
+	DrawQuad(position, size, 0.0f, color);
+}
+
+void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const Texture& texture, const glm::vec4& tint)
+{
+	// Culled before the slot lookup, an invisible quad must not take a texture unit
+	if (!IsVisible(position, size))
+	{
+		m_Stats.CulledQuads++;
+		return;
+	}
+	DrawQuad(position, size, GetTextureSlot(texture), tint);
+}
+
+void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, float textureSlot, const glm::vec4& tint)
+{
+	FlushShapes();  // shapes submitted before this quad are drawn first
+	if (m_QuadCount >= m_MaxQuads)
+		Flush();  // the batch is full: draw it and start a new one
+
+	if (m_Format == VertexFormat::Packed)
+	{
+		// Same conversions as the bulk path
+		QuadSpriteData sprite;
+		sprite.PositionX = &position.x;
+		sprite.PositionY = &position.y;
+		sprite.Width = &size.x;
+		sprite.Height = &size.y;
+		sprite.ColorR = &tint.r;
+		sprite.ColorG = &tint.g;
+		sprite.ColorB = &tint.b;
+		sprite.ColorA = &tint.a;
+		sprite.DefaultTexIndex = textureSlot;
+		GeneratePackedQuadVertices(sprite, 0, 1, (PackedQuadVertex*)m_QuadBufferPtr);
+	}
+	else
+	{
+		const float x0 = position.x, y0 = position.y;
+		const float x1 = position.x + size.x, y1 = position.y + size.y;
+		const float corners[4][2] = { { x0, y0 }, { x1, y0 }, { x1, y1 }, { x0, y1 } };
+		const float texCoords[4][2] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+
+		QuadVertex* vertex = (QuadVertex*)m_QuadBufferPtr;
+		for (int i = 0; i < 4; ++i)
+		{
+			vertex->Position[0] = corners[i][0];
+			vertex->Position[1] = corners[i][1];
+			vertex->Color[0] = tint.r;
+			vertex->Color[1] = tint.g;
+			vertex->Color[2] = tint.b;
+			vertex->Color[3] = tint.a;
+			vertex->TexCoords[0] = texCoords[i][0];
+			vertex->TexCoords[1] = texCoords[i][1];
+			vertex->TexID = textureSlot;
+			vertex++;
+		}
+	}
+	m_QuadBufferPtr += 4 * m_VertexSize;
+
+	m_QuadCount++;
+	m_Stats.QuadCount++;
+}
+
+void Renderer2D::DrawQuads(const QuadSpriteData& sprites, unsigned int count, const Texture* texture)
+{
+	QuadSpriteData data = sprites;
+
+	if (m_CullingEnabled)
+	{
+		if (m_VisibleIndices.size() < count)
+			m_VisibleIndices.resize(count);
+		unsigned int visible = CullQuads(sprites, count, m_ViewRect, m_VisibleIndices.data());
+		m_Stats.CulledQuads += count - visible;
+
+		if (visible == 0)
+			return;
+		// Only the visible sprites are copied, the generator then walks them as a dense range
+		if (visible < count)
+			GatherQuads(sprites, m_VisibleIndices.data(), visible, m_CullScratch, data);
+		count = visible;
+	}
+
+	FlushShapes();
+
+	// Flushing on a full batch keeps the texture slots, so one lookup covers every sprite
+	data.TexIndex = nullptr;
+	data.DefaultTexIndex = texture ? GetTextureSlot(*texture) : 0.0f;
+
+	unsigned int first = 0;
+	while (first < count)
+	{
+		if (m_QuadCount >= m_MaxQuads)
+			Flush();
+
+		// Fill the batch as far as it goes, the rest is written after the flush
+		unsigned int n = count - first;
+		if (n > m_MaxQuads - m_QuadCount)
+			n = m_MaxQuads - m_QuadCount;
+
+		if (m_Format == VertexFormat::Packed)
+			GeneratePackedQuadVertices(data, first, n, (PackedQuadVertex*)m_QuadBufferPtr);
+		else
+			GenerateQuadVertices(data, first, n, (QuadVertex*)m_QuadBufferPtr);
+		m_QuadBufferPtr += n * 4 * m_VertexSize;
+		m_QuadCount += n;
+		m_Stats.QuadCount += n;
+		first += n;
+	}
+}
+
+void Renderer2D::DrawStaticBatch(StaticBatch& batch)
+{
+	ASSERT(batch.GetVertexFormat() == m_Format);
+
+	if (batch.Build())
+		m_Stats.StaticRebuilds++;
+
+	const unsigned int quadCount = batch.GetQuadCount();
+	if (quadCount == 0)
+		return;
+
+	if (m_CullingEnabled)
+	{
+		const CullRect& bounds = batch.GetBounds();
+		if (bounds.MaxX < m_ViewRect.MinX || bounds.MinX > m_ViewRect.MaxX ||
+			bounds.MaxY < m_ViewRect.MinY || bounds.MinY > m_ViewRect.MaxY)
+		{
+			m_Stats.CulledQuads += quadCount;
+			return;
+		}
+	}
+
+	// Quads submitted before the batch must be drawn before it
+	Flush();
+
+	// The batch brings its own texture table, which replaces the slots of the current batch
+	const auto& textures = batch.GetTextures();
+	ASSERT(textures.size() < m_MaxTextureSlots);
+	for (unsigned int i = 0; i < textures.size(); ++i)
+	{
+		textures[i]->Bind(i + 1);
+		m_Stats.TextureBinds++;
+	}
+
+	m_Shader->Bind();
+	m_Shader->SetUniform1i(m_SDFSlotsUniform, 0);
+
+	Renderer renderer;
+	renderer.Draw(batch.GetVertexArray(), batch.GetIndexBuffer(), *m_Shader, quadCount * 6);
+	m_Stats.DrawCalls++;
+	m_Stats.StaticQuads += quadCount;
+
+	// Units 1..n now hold the batch's textures, the next dynamic quads start over
+	for (unsigned int i = 1; i < m_TextureSlotIndex; ++i)
+		m_TextureSlots[i] = nullptr;
+	m_TextureSlotIndex = 1;
+	m_SDFSlots = 0;
+}
+
+void Renderer2D::DrawTilemap(Tilemap& tilemap)
+{
+	ASSERT(tilemap.GetVertexFormat() == m_Format);
+
+	// Chunk range under the view; without culling the whole map
+	const float chunkSize = Tilemap::ChunkSize * tilemap.GetTileSize();
+	int firstX = 0, firstY = 0;
+	int endX = tilemap.GetChunkCountX(), endY = tilemap.GetChunkCountY();
+	if (m_CullingEnabled)
+	{
+		firstX = std::max(firstX, (int)floorf(m_ViewRect.MinX / chunkSize));
+		firstY = std::max(firstY, (int)floorf(m_ViewRect.MinY / chunkSize));
+		endX = std::min(endX, (int)floorf(m_ViewRect.MaxX / chunkSize) + 1);
+		endY = std::min(endY, (int)floorf(m_ViewRect.MaxY / chunkSize) + 1);
+	}
+	if (firstX >= endX || firstY >= endY)
+		return;
+
+	// Quads submitted before the map must be drawn before it
+	Flush();
+
+	tilemap.GetTileset().Bind(1);
+	m_Stats.TextureBinds++;
+
+	m_Shader->Bind();
+	m_Shader->SetUniform1i(m_SDFSlotsUniform, 0);
+
+	Renderer renderer;
+	for (int y = firstY; y < endY; ++y)
+	{
+		for (int x = firstX; x < endX; ++x)
+		{
+			const Tilemap::Chunk& chunk = tilemap.PrepareChunk(x, y, m_FrameIndex);
+			if (chunk.QuadCount == 0)
+				continue;
+
+			renderer.Draw(*chunk.VAO, tilemap.GetIndexBuffer(), *m_Shader, chunk.QuadCount * 6);
+			m_Stats.DrawCalls++;
+			m_Stats.TilemapChunks++;
+			m_Stats.StaticQuads += chunk.QuadCount;
+		}
+	}
+
+	// Unit 1 now holds the tileset, the next dynamic quads start over
+	for (unsigned int i = 1; i < m_TextureSlotIndex; ++i)
+		m_TextureSlots[i] = nullptr;
+	m_TextureSlotIndex = 1;
+	m_SDFSlots = 0;
+}
+
+void Renderer2D::DrawString(const std::string& text, const glm::vec2& position, float pixelHeight, const Font& font, const glm::vec4& color)
+{
+	if (!font.IsLoaded() || text.empty())
+		return;
+
+	for (auto& array : m_TextArrays)
+		array.resize(text.size());
+	float* x = m_TextArrays[0].data();
+	float* y = m_TextArrays[1].data();
+	float* width = m_TextArrays[2].data();
+	float* height = m_TextArrays[3].data();
+	float* u0 = m_TextArrays[4].data();
+	float* v0 = m_TextArrays[5].data();
+	float* u1 = m_TextArrays[6].data();
+	float* v1 = m_TextArrays[7].data();
+
+	const float scale = pixelHeight / font.GetPixelHeight();
+	glm::vec2 pen = position;
+	const Glyph* previous = nullptr;
+	unsigned int count = 0;
+	CullRect bounds{ 0.0f, 0.0f, 0.0f, 0.0f };
+
+	for (size_t i = 0; i < text.size();)
+	{
+		const unsigned int codepoint = Font::DecodeUTF8(text, i);
+		if (codepoint == '\n')
+		{
+			pen.x = position.x;
+			pen.y -= font.GetLineHeight() * scale;
+			previous = nullptr;
+			continue;
+		}
+
+		const Glyph* glyph = font.GetGlyph(codepoint);
+		if (!glyph)
+			continue;
+		if (previous)
+			pen.x += font.GetKerning(*previous, *glyph) * scale;
+		previous = glyph;
+
+		// Glyph offsets point down from the baseline, the world points up. The atlas rows are
+		// top down, so the bottom of the quad samples V1.
+		if (glyph->Width > 0.0f)
+		{
+			x[count] = pen.x + glyph->OffsetX * scale;
+			y[count] = pen.y - (glyph->OffsetY + glyph->Height) * scale;
+			width[count] = glyph->Width * scale;
+			height[count] = glyph->Height * scale;
+			u0[count] = glyph->U0;
+			v0[count] = glyph->V1;
+			u1[count] = glyph->U1;
+			v1[count] = glyph->V0;
+
+			if (count == 0 || x[count] < bounds.MinX) bounds.MinX = x[count];
+			if (count == 0 || y[count] < bounds.MinY) bounds.MinY = y[count];
+			if (count == 0 || x[count] + width[count] > bounds.MaxX) bounds.MaxX = x[count] + width[count];
+			if (count == 0 || y[count] + height[count] > bounds.MaxY) bounds.MaxY = y[count] + height[count];
+			count++;
+		}
+		pen.x += glyph->Advance * scale;
+	}
+
+	if (count == 0)
+		return;
+	// Culled as a whole before the slot lookup, an invisible string must not take a texture unit
+	if (m_CullingEnabled &&
+		(bounds.MaxX < m_ViewRect.MinX || bounds.MinX > m_ViewRect.MaxX ||
+		 bounds.MaxY < m_ViewRect.MinY || bounds.MinY > m_ViewRect.MaxY))
+	{
+		m_Stats.CulledQuads += count;
+		return;
+	}
+
+	// The slot is taken before the quads so that it can be flagged, DrawQuads finds it again
+	const unsigned int slot = (unsigned int)GetTextureSlot(font.GetAtlas());
+	if (font.IsSDF())
+		m_SDFSlots |= 1u << slot;
+
+	QuadSpriteData sprites;
+	sprites.PositionX = x;
+	sprites.PositionY = y;
+	sprites.Width = width;
+	sprites.Height = height;
+	sprites.U0 = u0;
+	sprites.V0 = v0;
+	sprites.U1 = u1;
+	sprites.V1 = v1;
+	for (int c = 0; c < 4; ++c)
+		sprites.DefaultColor[c] = color[c];
+	DrawQuads(sprites, count, &font.GetAtlas());
+}
+
+void Renderer2D::DrawCircle(const glm::vec2& center, float radius, const glm::vec4& color)
+{
+	DrawShape(ShapeCircle, center, glm::vec2(1.0f, 0.0f), glm::vec2(radius), glm::vec4(radius, 0.0f, 0.0f, 0.0f), color);
+}
+
+void Renderer2D::DrawRing(const glm::vec2& center, float radius, float thickness, const glm::vec4& color)
+{
+	const float outer = radius + thickness * 0.5f;
+	DrawShape(ShapeRing, center, glm::vec2(1.0f, 0.0f), glm::vec2(outer), glm::vec4(radius, thickness * 0.5f, 0.0f, 0.0f), color);
+}
+
+void Renderer2D::DrawRoundedRect(const glm::vec2& position, const glm::vec2& size, float cornerRadius, const glm::vec4& color)
+{
+	const glm::vec2 halfSize = size * 0.5f;
+	DrawShape(ShapeRoundedRect, position + halfSize, glm::vec2(1.0f, 0.0f), halfSize, glm::vec4(halfSize, cornerRadius, 0.0f), color);
+}
+
+void Renderer2D::DrawCapsule(const glm::vec2& from, const glm::vec2& to, float radius, const glm::vec4& color)
+{
+	// A rounded rect along the segment whose corner radius is half its height
+	const glm::vec2 delta = to - from;
+	const float length = glm::length(delta);
+	const glm::vec2 axis = length > 0.0f ? delta / length : glm::vec2(1.0f, 0.0f);
+	const glm::vec2 halfSize(length * 0.5f + radius, radius);
+	DrawShape(ShapeRoundedRect, (from + to) * 0.5f, axis, halfSize, glm::vec4(halfSize, radius, 0.0f), color);
+}
+
+void Renderer2D::DrawShape(Shape shape, const glm::vec2& center, const glm::vec2& axis, const glm::vec2& halfSize, const glm::vec4& params, const glm::vec4& color)
+{
+	const glm::vec2 extent = halfSize + ShapeEdgeMargin;
+	const glm::vec2 axisX = axis * extent.x;
+	const glm::vec2 axisY = glm::vec2(-axis.y, axis.x) * extent.y;
+
+	// Bounding box of the (possibly rotated) quad
+	const glm::vec2 reach(fabsf(axisX.x) + fabsf(axisY.x), fabsf(axisX.y) + fabsf(axisY.y));
+	if (!IsVisible(center - reach, reach * 2.0f))
+	{
+		m_Stats.CulledQuads++;
+		return;
+	}
+
+	FlushQuads();  // quads submitted before this shape are drawn first
+	if (m_ShapeCount >= m_MaxQuads)
+		FlushShapes();
+
+	unsigned char packedColor[4];
+	for (int c = 0; c < 4; ++c)
+	{
+		const float value = color[c] < 0.0f ? 0.0f : (color[c] > 1.0f ? 1.0f : color[c]);
+		packedColor[c] = (unsigned char)(value * 255.0f + 0.5f);
+	}
+
+	const float corners[4][2] = { { -1.0f, -1.0f }, { 1.0f, -1.0f }, { 1.0f, 1.0f }, { -1.0f, 1.0f } };
+	for (int i = 0; i < 4; ++i)
+	{
+		const glm::vec2 position = center + axisX * corners[i][0] + axisY * corners[i][1];
+		ShapeVertex& vertex = *m_ShapeBufferPtr++;
+		vertex.Position[0] = position.x;
+		vertex.Position[1] = position.y;
+		vertex.Local[0] = extent.x * corners[i][0];
+		vertex.Local[1] = extent.y * corners[i][1];
+		for (int p = 0; p < 4; ++p)
+			vertex.Params[p] = params[p];
+		for (int c = 0; c < 4; ++c)
+			vertex.Color[c] = packedColor[c];
+		vertex.Shape = shape;
+		vertex.Padding[0] = vertex.Padding[1] = vertex.Padding[2] = 0;
+	}
+
+	m_ShapeCount++;
+	m_Stats.ShapeCount++;
+}
+
+void Renderer2D::ResetStats()
+{
+	m_Stats = Statistics();
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+#include "Shader.h"
+#include "Texture.h"
+#include "QuadGenerator.h"
+#include "QuadCulling.h"
+
+class StaticBatch;
+class Tilemap;
+class Font;
+class VertexBufferLayout;
+
+class Renderer2D
+{
+public:
+	enum class VertexFormat
+	{
+		Float,   // QuadVertex, 36 bytes
+		Packed   // PackedQuadVertex, 20 bytes
+	};
+
+	struct Statistics
+	{
+		unsigned int DrawCalls = 0;
+		unsigned int QuadCount = 0;
+		unsigned int TextureBinds = 0;
+		unsigned int BufferStalls = 0;  // flushes that had to wait for the GPU to release a region
+		unsigned int CulledQuads = 0;   // quads outside the view, dropped before any vertex was written
+		unsigned int StaticQuads = 0;   // drawn from static batches, no vertex written this frame
+		unsigned int ShapeCount = 0;    // SDF shapes, one quad each
+		unsigned int TilemapChunks = 0; // chunks drawn, one draw call each
+		unsigned int StaticRebuilds = 0;
+	};
+
+	Renderer2D(unsigned int maxQuads = 10000, VertexFormat format = VertexFormat::Float);
+	~Renderer2D();
+
+	void BeginScene(const glm::mat4& viewProjection);
+	void EndScene();
+	void Flush();
+
+	void DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color);
+	void DrawQuad(const glm::vec2& position, const glm::vec2& size, const Texture& texture, const glm::vec4& tint = glm::vec4(1.0f));
+	// Bulk path, vertices are generated with SIMD. Every sprite uses texture (or none); sprites.TexIndex is ignored.
+	void DrawQuads(const QuadSpriteData& sprites, unsigned int count, const Texture* texture = nullptr);
+	// Glyph quads go into the current batch like any sprite. position is the start of the
+	// first baseline, pixelHeight the size of the text (the font may be baked at another size).
+	void DrawString(const std::string& text, const glm::vec2& position, float pixelHeight, const Font& font, const glm::vec4& color = glm::vec4(1.0f));
+
+	// Analytic shapes: one quad each, the fragment shader evaluates the signed distance and
+	// antialiases the edge. They are batched apart from the sprites; switching between the
+	// two flushes, so that draw order is kept.
+	void DrawCircle(const glm::vec2& center, float radius, const glm::vec4& color);
+	void DrawRing(const glm::vec2& center, float radius, float thickness, const glm::vec4& color);
+	void DrawRoundedRect(const glm::vec2& position, const glm::vec2& size, float cornerRadius, const glm::vec4& color);
+	void DrawCapsule(const glm::vec2& from, const glm::vec2& to, float radius, const glm::vec4& color);
+
+	// Rebuilds the batch if its sprites changed, then draws its retained vertices in one call
+	void DrawStaticBatch(StaticBatch& batch);
+
+	// Draws the chunks of the map that intersect the view, building the ones that need it
+	void DrawTilemap(Tilemap& tilemap);
+
+	// Attributes of the vertex format, for vertex buffers drawn with the Renderer2D shader
+	static VertexBufferLayout CreateVertexLayout(VertexFormat format);
+
+	inline unsigned int GetMaxTextureSlots() const { return m_MaxTextureSlots; }
+	inline VertexFormat GetVertexFormat() const { return m_Format; }
+	inline unsigned int GetVertexSize() const { return m_VertexSize; }
+
+	// Quads outside the view rectangle of the scene are skipped on the CPU
+	inline void SetCullingEnabled(bool enabled) { m_CullingEnabled = enabled; }
+	inline bool IsCullingEnabled() const { return m_CullingEnabled; }
+
+	inline const Statistics& GetStats() const { return m_Stats; }
+	void ResetStats();
+
+private:
+	// Shape ids, must match SDFShapes.shader
+	enum Shape : unsigned char
+	{
+		ShapeCircle = 0,       // Params.x radius
+		ShapeRing = 1,         // Params.x radius, Params.y half thickness
+		ShapeRoundedRect = 2   // Params.xy half size, Params.z corner radius (capsules too)
+	};
+
+	void StartBatch();
+	void FlushQuads();
+	void StartShapeBatch();
+	void FlushShapes();
+	// axis is the unit x axis of the shape's frame, halfSize its extent along both axes
+	void DrawShape(Shape shape, const glm::vec2& center, const glm::vec2& axis, const glm::vec2& halfSize, const glm::vec4& params, const glm::vec4& color);
+	void ResetTextureSlots();
+	float GetTextureSlot(const Texture& texture);
+	bool IsVisible(const glm::vec2& position, const glm::vec2& size) const;
+	void DrawQuad(const glm::vec2& position, const glm::vec2& size, float textureSlot, const glm::vec4& tint);
+
+	unsigned int m_MaxQuads;
+	unsigned int m_MaxVertices;
+	VertexFormat m_Format;
+	unsigned int m_VertexSize;
+
+	std::unique_ptr<VertexArray> m_VAO;
+	std::unique_ptr<VertexBuffer> m_VertexBuffer;
+	std::shared_ptr<IndexBuffer> m_IndexBuffer;
+	std::unique_ptr<Shader> m_Shader;
+	UniformHandle m_SDFSlotsUniform;  // set on every flush
+	std::unique_ptr<Texture> m_WhiteTexture;  // bound to slot 0 so that flat colored quads can share the textured batch
+
+	// Textures referenced by the current batch, index = texture unit. Slot 0 is the white texture.
+	unsigned int m_MaxTextureSlots;
+	std::vector<const Texture*> m_TextureSlots;
+	unsigned int m_TextureSlotIndex;
+	unsigned int m_SDFSlots;  // bit i set: slot i holds a distance field font atlas
+
+	// Current region of the streaming vertex buffer, written in place by the Draw calls
+	unsigned char* m_QuadBufferBase;
+	unsigned char* m_QuadBufferPtr;
+	unsigned int m_QuadCount;
+
+	glm::mat4 m_ViewProjection;
+	Statistics m_Stats;
+	unsigned int m_FrameIndex;  // counts scenes, tells tilemaps which chunks are in use
+
+	// Analytic shapes, streamed like the quads
+	std::unique_ptr<VertexArray> m_ShapeVAO;
+	std::unique_ptr<VertexBuffer> m_ShapeVertexBuffer;
+	std::unique_ptr<Shader> m_ShapeShader;
+	ShapeVertex* m_ShapeBufferBase;
+	ShapeVertex* m_ShapeBufferPtr;
+	unsigned int m_ShapeCount;
+
+	// World space rectangle covered by m_ViewProjection, updated by BeginScene
+	bool m_CullingEnabled;
+	CullRect m_ViewRect;
+	std::vector<unsigned int> m_VisibleIndices;
+	QuadSpriteScratch m_CullScratch;
+
+	// Glyph quads of DrawString, as sprites for DrawQuads
+	std::vector<float> m_TextArrays[8];
+};
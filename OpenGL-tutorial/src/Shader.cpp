@@ -4,6 +4,8 @@
 #include <fstream>
 #include <string>
 #include <sstream>
+#include <algorithm>
+#include <cstring>
 
 #include "Renderer.h"
 
@@ -12,47 +14,114 @@ Shader::Shader(const std::string & filepath)
 	:m_Filepath(filepath), m_RendererID(0)
 {
 	ShaderProgramSource source = ParseShader(filepath);
-	m_RendererID = CreateShader(source.VertexSource, source.FragmentSource);
+	if (!source.ComputeSource.empty())
+		m_RendererID = CreateComputeShader(source.ComputeSource);
+	else
+		m_RendererID = CreateShader(source.VertexSource, source.FragmentSource);
+	ReflectUniforms();
+}
+
+Shader::Shader(const std::string & filepath, const std::unordered_map<std::string, std::string>& defines)
+	:m_Filepath(filepath), m_RendererID(0)
+{
+	ShaderProgramSource source = ParseShader(filepath);
+	if (!source.ComputeSource.empty())
+		m_RendererID = CreateComputeShader(InjectDefines(source.ComputeSource, defines));
+	else
+		m_RendererID = CreateShader(InjectDefines(source.VertexSource, defines), InjectDefines(source.FragmentSource, defines));
+	ReflectUniforms();
 }
 
 Shader::~Shader()
 {
 	GLCall(glDeleteProgram(m_RendererID));
+	GLStateCache::OnProgramDeleted(m_RendererID);
 }
 
 void Shader::Bind() const
 {
-	GLCall(glUseProgram(m_RendererID));
+	GLStateCache::UseProgram(m_RendererID);
 }
 
 void Shader::Unbind() const
 {
-	GLCall(glUseProgram(0));
+	GLStateCache::UseProgram(0);
+}
+
+void Shader::SetUniform1i(UniformHandle handle, int value)
+{
+	if (handle.IsValid() && UpdateShadow(handle, &value, sizeof(value)))
+	{
+		GLCall(glUniform1i(m_Uniforms[handle.Index].Location, value));
+	}
+}
+
+void Shader::SetUniform1iv(UniformHandle handle, int count, const int * values)
+{
+	if (handle.IsValid() && UpdateShadow(handle, values, count * sizeof(int)))
+	{
+		GLCall(glUniform1iv(m_Uniforms[handle.Index].Location, count, values));
+	}
+}
+
+void Shader::SetUniform1f(UniformHandle handle, float value)
+{
+	if (handle.IsValid() && UpdateShadow(handle, &value, sizeof(value)))
+	{
+		GLCall(glUniform1f(m_Uniforms[handle.Index].Location, value));
+	}
 }
 
-void Shader::SetUniform1i(const std::string & name, int value)
+void Shader::SetUniform4f(UniformHandle handle, float v0, float v1, float v2, float v3)
 {
-	GLCall(glUniform1i(GetUniformLocation(name), value));
+	const float value[4] = { v0, v1, v2, v3 };
+	if (handle.IsValid() && UpdateShadow(handle, value, sizeof(value)))
+	{
+		GLCall(glUniform4f(m_Uniforms[handle.Index].Location, v0, v1, v2, v3));
+	}
 }
 
-void Shader::SetUniform1iv(const std::string & name, int count, const int * values)
+void Shader::SetUniformMat4f(UniformHandle handle, const glm::mat4& matrix)
 {
-	GLCall(glUniform1iv(GetUniformLocation(name), count, values));
+	if (handle.IsValid() && UpdateShadow(handle, &matrix[0][0], sizeof(glm::mat4)))
+	{
+		GLCall(glUniformMatrix4fv(m_Uniforms[handle.Index].Location, 1, GL_FALSE, &matrix[0][0]));
+	}
 }
 
-void Shader::SetUniform1f(const std::string & name, float value)
+static UniformStats s_TotalUniformStats;
+
+const UniformStats& Shader::GetTotalUniformStats()
 {
-	GLCall(glUniform1f(GetUniformLocation(name), value));
+	return s_TotalUniformStats;
 }
 
-void Shader::SetUniform4f(const std::string & name, float v0, float v1, float v2, float v3)
+void Shader::ResetTotalUniformStats()
 {
-	GLCall(glUniform4f(GetUniformLocation(name), v0, v1, v2, v3));
+	s_TotalUniformStats = UniformStats();
 }
 
-void Shader::SetUniformMat4f(const std::string & name, glm::mat4 & matrix)
+bool Shader::UpdateShadow(UniformHandle handle, const void* value, unsigned int size)
 {
-	GLCall(glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, &matrix[0][0]));
+	UniformInfo& uniform = m_Uniforms[handle.Index];
+
+	// The driver may trim the unused tail of an array, GL ignores the values past it
+	size = std::min(size, uniform.ValueSize);
+
+	unsigned char* shadow = m_UniformValues.data() + uniform.ValueOffset;
+	if (uniform.ValueKnown && memcmp(shadow, value, size) == 0)
+	{
+		m_UniformStats.ElidedUploads++;
+		s_TotalUniformStats.ElidedUploads++;
+		return false;
+	}
+
+	// Setting part of an array leaves the rest unknown
+	memcpy(shadow, value, size);
+	uniform.ValueKnown = uniform.ValueKnown || size == uniform.ValueSize;
+	m_UniformStats.Uploads++;
+	s_TotalUniformStats.Uploads++;
+	return true;
 }
 
 ShaderProgramSource Shader::ParseShader(const std::string& filepath)
@@ -61,11 +130,11 @@ ShaderProgramSource Shader::ParseShader(const std::string& filepath)
 
 	enum class ShaderType
 	{
-		NONE = -1, VERTEX = 0, FRAGMENT = 1
+		NONE = -1, VERTEX = 0, FRAGMENT = 1, COMPUTE = 2
 	};
 
 	std::string line;
-	std::stringstream ss[2];
+	std::stringstream ss[3];
 	ShaderType type = ShaderType::NONE;
 	while (getline(stream, line))
 	{
@@ -81,6 +150,11 @@ ShaderProgramSource Shader::ParseShader(const std::string& filepath)
 				// set mode to fragment
 				type = ShaderType::FRAGMENT;
 			}
+			else if (line.find("compute") != std::string::npos)
+			{
+				// set mode to compute
+				type = ShaderType::COMPUTE;
+			}
 		}
 		else
 		{
@@ -88,7 +162,24 @@ ShaderProgramSource Shader::ParseShader(const std::string& filepath)
 		}
 	}
 
-	return { ss[0].str(), ss[1].str() };
+	return { ss[0].str(), ss[1].str(), ss[2].str() };
+}
+
+std::string Shader::InjectDefines(const std::string & source, const std::unordered_map<std::string, std::string>& defines)
+{
+	// #version must stay the first statement, so the defines go right after it
+	size_t position = source.find("#version");
+	position = (position == std::string::npos) ? 0 : source.find('\n', position) + 1;
+
+	std::stringstream ss;
+	for (const auto& define : defines)
+	{
+		ss << "#define " << define.first << ' ' << define.second << '\n';
+	}
+
+	std::string result = source;
+	result.insert(position, ss.str());
+	return result;
 }
 
 unsigned int Shader::CompileShader(unsigned int type, const std::string& source)
@@ -106,7 +197,7 @@ unsigned int Shader::CompileShader(unsigned int type, const std::string& source)
 		glGetShaderiv(id, GL_INFO_LOG_LENGTH, &length);
 		char* message = (char *)alloca(length * sizeof(char));
 		glGetShaderInfoLog(id, length, &length, message);
-		std::cout << "Failed to compile " << (type == GL_VERTEX_SHADER ? "vertex" : "fragment") << " shader\n";
+		std::cout << "Failed to compile " << (type == GL_VERTEX_SHADER ? "vertex" : (type == GL_FRAGMENT_SHADER ? "fragment" : "compute")) << " shader\n";
 		std::cout << message << '\n';
 		glDeleteShader(id);
 		return 0;
@@ -115,23 +206,93 @@ unsigned int Shader::CompileShader(unsigned int type, const std::string& source)
 	return id;
 }
 
-int Shader::GetUniformLocation(const std::string & name)
+// Bytes of one element of a uniform of this type; samplers and images are set as ints
+static unsigned int GetUniformTypeSize(GLenum type)
 {
-	if (m_UniformLocationCache.find(name) != m_UniformLocationCache.end())
+	switch (type)
 	{
-		return m_UniformLocationCache[name];
+	case GL_FLOAT_VEC2: case GL_INT_VEC2: case GL_UNSIGNED_INT_VEC2: case GL_BOOL_VEC2: return 8;
+	case GL_FLOAT_VEC3: case GL_INT_VEC3: case GL_UNSIGNED_INT_VEC3: case GL_BOOL_VEC3: return 12;
+	case GL_FLOAT_VEC4: case GL_INT_VEC4: case GL_UNSIGNED_INT_VEC4: case GL_BOOL_VEC4: return 16;
+	case GL_FLOAT_MAT2: return 16;
+	case GL_FLOAT_MAT3: return 36;
+	case GL_FLOAT_MAT4: return 64;
+	default: return 4;
 	}
-	else
+}
+
+UniformHandle Shader::GetUniformHandle(UniformID id) const
+{
+	auto it = std::lower_bound(m_Uniforms.begin(), m_Uniforms.end(), id.Hash,
+		[](const UniformInfo& uniform, uint32_t hash) { return uniform.Hash < hash; });
+
+	UniformHandle handle;
+	if (it != m_Uniforms.end() && it->Hash == id.Hash)
+	{
+		handle.Index = (int)(it - m_Uniforms.begin());
+		return handle;
+	}
+
+	// Once per name, the lookup of a missing uniform stays silent afterwards
+	if (std::find(m_MissingUniforms.begin(), m_MissingUniforms.end(), id.Hash) == m_MissingUniforms.end())
+	{
+		std::cout << "Warining: uniform '" << id.Name << "' doesn't exist!\n";
+		m_MissingUniforms.push_back(id.Hash);
+	}
+	return handle;
+}
+
+void Shader::ReflectUniforms()
+{
+	int count = 0, maxLength = 0;
+	GLCall(glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORMS, &count));
+	GLCall(glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength));
+
+	std::vector<char> name(maxLength + 1);
+	for (int i = 0; i < count; ++i)
 	{
-		GLCall(int location = glGetUniformLocation(m_RendererID, name.c_str()));
+		int length = 0, size = 0;
+		GLenum type = 0;
+		GLCall(glGetActiveUniform(m_RendererID, (GLuint)i, (GLsizei)name.size(), &length, &size, &type, name.data()));
+
+		// Members of uniform blocks have no location, the block is bound instead
+		GLCall(int location = glGetUniformLocation(m_RendererID, name.data()));
 		if (location == -1)
+			continue;
+
+		UniformInfo uniform;
+		uniform.Name.assign(name.data(), length);
+		if (uniform.Name.size() > 3 && uniform.Name.compare(uniform.Name.size() - 3, 3, "[0]") == 0)
+			uniform.Name.resize(uniform.Name.size() - 3);
+		uniform.Hash = HashUniformName(uniform.Name.c_str());
+		uniform.Location = location;
+		uniform.Type = type;
+		uniform.Count = size;
+		uniform.ValueSize = GetUniformTypeSize(type) * size;
+		uniform.ValueKnown = false;
+		m_Uniforms.push_back(uniform);
+	}
+
+	std::sort(m_Uniforms.begin(), m_Uniforms.end(),
+		[](const UniformInfo& a, const UniformInfo& b) { return a.Hash < b.Hash; });
+
+	for (size_t i = 1; i < m_Uniforms.size(); ++i)
+	{
+		if (m_Uniforms[i].Hash == m_Uniforms[i - 1].Hash)
 		{
-			std::cout << "Warining: uniform '" << name << "' doesn't exist!\n";
+			std::cout << "Error: uniforms '" << m_Uniforms[i - 1].Name << "' and '" << m_Uniforms[i].Name
+				<< "' have the same hash in " << m_Filepath << '\n';
+			ASSERT(false);
 		}
-		m_UniformLocationCache[name] = location;
-		return location;
 	}
-	
+
+	unsigned int valuesSize = 0;
+	for (UniformInfo& uniform : m_Uniforms)
+	{
+		uniform.ValueOffset = valuesSize;
+		valuesSize += uniform.ValueSize;
+	}
+	m_UniformValues.resize(valuesSize);
 }
 
 unsigned int Shader::CreateShader(const std::string& VertexShader, const std::string& FragmentShader)
@@ -144,11 +305,36 @@ unsigned int Shader::CreateShader(const std::string& VertexShader, const std::st
 	glAttachShader(Program, fs);
 	glLinkProgram(Program);
 	glValidateProgram(Program);
+	BindUniformBlocks(Program);
 
 	// We got a program so we can delete our shader source code.
 	// The shader source is necessary for debugging.
 	glDeleteShader(vs);
 	glDeleteShader(fs);
 
+	return Program;
+}
+
+void Shader::BindUniformBlocks(unsigned int program)
+{
+	// Blocks the program does not use are simply not there
+	GLCall(unsigned int camera = glGetUniformBlockIndex(program, "Camera"));
+	if (camera != GL_INVALID_INDEX)
+	{
+		GLCall(glUniformBlockBinding(program, camera, (unsigned int)UniformBinding::Camera));
+	}
+}
+
+unsigned int Shader::CreateComputeShader(const std::string& ComputeShader)
+{
+	unsigned int Program = glCreateProgram();
+	unsigned int cs = CompileShader(GL_COMPUTE_SHADER, ComputeShader);
+
+	glAttachShader(Program, cs);
+	glLinkProgram(Program);
+	glValidateProgram(Program);
+
+	glDeleteShader(cs);
+
 	return Program;
 }
\ No newline at end of file
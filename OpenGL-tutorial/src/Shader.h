@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "glm/glm.hpp"
 
@@ -9,31 +11,108 @@ struct ShaderProgramSource
 {
 	std::string VertexSource;
 	std::string FragmentSource;
+	std::string ComputeSource;  // a file with a compute section is a compute-only program
+};
+
+// 32-bit FNV-1a of a uniform name. constexpr, so that the name of a literal is hashed by the compiler.
+constexpr uint32_t HashUniformName(const char* name, uint32_t hash = 2166136261u)
+{
+	return *name ? HashUniformName(name + 1, (hash ^ (uint32_t)(unsigned char)*name) * 16777619u) : hash;
+}
+
+// A uniform named by its hash. Built implicitly from a literal, so SetUniform1i("u_Texture", 0)
+// allocates nothing; declare it static constexpr where the hash must not be left to the optimizer.
+struct UniformID
+{
+	uint32_t Hash;
+	const char* Name;  // only for the warning about a missing uniform
+
+	constexpr UniformID(const char* name)
+		: Hash(HashUniformName(name)), Name(name)
+	{
+	}
+};
+
+// Index of a reflected uniform, valid as long as its Shader. Negative for a uniform the
+// program does not have: setting it does nothing.
+struct UniformHandle
+{
+	int Index = -1;
+
+	inline bool IsValid() const { return Index >= 0; }
+};
+
+// An active uniform as reported by the driver after linking
+struct UniformInfo
+{
+	std::string Name;  // arrays without the [0] suffix
+	uint32_t Hash;
+	int Location;
+	unsigned int Type;  // GL_FLOAT_VEC4, GL_SAMPLER_2D, ...
+	int Count;          // elements of an array, 1 otherwise
+
+	unsigned int ValueOffset;  // of the last value set, in the shadow copy of the Shader
+	unsigned int ValueSize;    // bytes of the whole array
+	bool ValueKnown;           // false until the first set of the whole value
+};
+
+// glUniform calls made and skipped because the program already had the value
+struct UniformStats
+{
+	unsigned int Uploads = 0;
+	unsigned int ElidedUploads = 0;
 };
 
 class Shader
 {
 public:
 	Shader(const std::string& filepath);
+	Shader(const std::string& filepath, const std::unordered_map<std::string, std::string>& defines);  // each entry becomes a #define after #version
 	~Shader();
 
 	void Bind() const;
 	void Unbind() const;
 
-	void SetUniform1i(const std::string& name, int value);
-	void SetUniform1iv(const std::string& name, int count, const int * values);
-	void SetUniform1f(const std::string& name, float value);
-	void SetUniform4f(const std::string& name, float v0, float v1, float v2, float v3);
-	void SetUniformMat4f(const std::string& name, glm::mat4& matrix);
+	inline unsigned int GetRendererID() const { return m_RendererID; }
+
+	// Resolved once, then every set is a plain array access
+	UniformHandle GetUniformHandle(UniformID id) const;
+	inline const std::vector<UniformInfo>& GetUniforms() const { return m_Uniforms; }
+
+	// Every set is compared with a CPU copy of the uniform and dropped when nothing changes.
+	// Counted per shader and over all shaders.
+	inline const UniformStats& GetUniformStats() const { return m_UniformStats; }
+	static const UniformStats& GetTotalUniformStats();
+	static void ResetTotalUniformStats();
+
+	void SetUniform1i(UniformHandle handle, int value);
+	void SetUniform1iv(UniformHandle handle, int count, const int * values);
+	void SetUniform1f(UniformHandle handle, float value);
+	void SetUniform4f(UniformHandle handle, float v0, float v1, float v2, float v3);
+	void SetUniformMat4f(UniformHandle handle, const glm::mat4& matrix);
+
+	// By name: a binary search over the hashes of the reflected uniforms
+	inline void SetUniform1i(UniformID id, int value) { SetUniform1i(GetUniformHandle(id), value); }
+	inline void SetUniform1iv(UniformID id, int count, const int * values) { SetUniform1iv(GetUniformHandle(id), count, values); }
+	inline void SetUniform1f(UniformID id, float value) { SetUniform1f(GetUniformHandle(id), value); }
+	inline void SetUniform4f(UniformID id, float v0, float v1, float v2, float v3) { SetUniform4f(GetUniformHandle(id), v0, v1, v2, v3); }
+	inline void SetUniformMat4f(UniformID id, const glm::mat4& matrix) { SetUniformMat4f(GetUniformHandle(id), matrix); }
 
 private:
 	std::string m_Filepath;
 	unsigned int m_RendererID;
-	std::unordered_map<std::string, int> m_UniformLocationCache;
+	std::vector<UniformInfo> m_Uniforms;  // sorted by hash
+	mutable std::vector<uint32_t> m_MissingUniforms;  // hashes already warned about
+	std::vector<unsigned char> m_UniformValues;  // shadow copy of every uniform's value
+	UniformStats m_UniformStats;
 
-	int GetUniformLocation(const std::string& name);
+	void ReflectUniforms();
+	bool UpdateShadow(UniformHandle handle, const void* value, unsigned int size);  // true if the value has to be uploaded
 
 	unsigned int CreateShader(const std::string& VertexShader, const std::string& FragmentShader);
+	unsigned int CreateComputeShader(const std::string& ComputeShader);
+	static void BindUniformBlocks(unsigned int program);  // shared blocks to their UniformBinding points
 	ShaderProgramSource ParseShader(const std::string& filepath);
+	static std::string InjectDefines(const std::string& source, const std::unordered_map<std::string, std::string>& defines);
 	unsigned int CompileShader(unsigned int type, const std::string& source);
 };
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "StaticBatch.h"
+
+#include "Renderer.h"
+#include "VertexBufferLayout.h"
+
+#include <algorithm>
+
+StaticBatch::StaticBatch(Renderer2D::VertexFormat format)
+	: m_Format(format), m_Generation(1), m_BuiltGeneration(0), m_BuildCount(0),
+	m_Bounds{ 0.0f, 0.0f, 0.0f, 0.0f }
+{
+}
+
+StaticBatch::~StaticBatch()
+{
+}
+
+unsigned int StaticBatch::AddQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color)
+{
+	m_PositionX.push_back(position.x);
+	m_PositionY.push_back(position.y);
+	m_Width.push_back(size.x);
+	m_Height.push_back(size.y);
+	m_ColorR.push_back(color.r);
+	m_ColorG.push_back(color.g);
+	m_ColorB.push_back(color.b);
+	m_ColorA.push_back(color.a);
+	m_TexIndex.push_back(0.0f);
+
+	m_Generation++;
+	return GetQuadCount() - 1;
+}
+
+unsigned int StaticBatch::AddQuad(const glm::vec2& position, const glm::vec2& size, const Texture& texture, const glm::vec4& tint)
+{
+	unsigned int index = AddQuad(position, size, tint);
+	m_TexIndex[index] = GetTextureSlot(texture);
+	return index;
+}
+
+void StaticBatch::SetQuad(unsigned int index, const glm::vec2& position, const glm::vec2& size, const glm::vec4& color)
+{
+	ASSERT(index < GetQuadCount());
+
+	const float values[8] = { position.x, position.y, size.x, size.y, color.r, color.g, color.b, color.a };
+	std::vector<float>* arrays[8] = { &m_PositionX, &m_PositionY, &m_Width, &m_Height, &m_ColorR, &m_ColorG, &m_ColorB, &m_ColorA };
+
+	bool changed = false;
+	for (int i = 0; i < 8; ++i)
+	{
+		float& value = (*arrays[i])[index];
+		changed |= value != values[i];
+		value = values[i];
+	}
+
+	if (changed)
+		m_Generation++;
+}
+
+void StaticBatch::Clear()
+{
+	for (auto* array : { &m_PositionX, &m_PositionY, &m_Width, &m_Height, &m_ColorR, &m_ColorG, &m_ColorB, &m_ColorA, &m_TexIndex })
+		array->clear();
+	m_Textures.clear();
+	m_Generation++;
+}
+
+float StaticBatch::GetTextureSlot(const Texture& texture)
+{
+	for (unsigned int i = 0; i < m_Textures.size(); ++i)
+	{
+		if (m_Textures[i] == &texture)
+			return (float)(i + 1);
+	}
+
+	m_Textures.push_back(&texture);
+	return (float)m_Textures.size();
+}
+
+bool StaticBatch::Build()
+{
+	if (!IsDirty())
+		return false;
+
+	const unsigned int quadCount = GetQuadCount();
+	const unsigned int vertexSize = m_Format == Renderer2D::VertexFormat::Packed ? sizeof(PackedQuadVertex) : sizeof(QuadVertex);
+	const unsigned int size = quadCount * 4 * vertexSize;
+
+	QuadSpriteData sprites;
+	sprites.PositionX = m_PositionX.data();
+	sprites.PositionY = m_PositionY.data();
+	sprites.Width = m_Width.data();
+	sprites.Height = m_Height.data();
+	sprites.ColorR = m_ColorR.data();
+	sprites.ColorG = m_ColorG.data();
+	sprites.ColorB = m_ColorB.data();
+	sprites.ColorA = m_ColorA.data();
+	sprites.TexIndex = m_TexIndex.data();
+
+	m_Vertices.resize(size);
+	if (m_Format == Renderer2D::VertexFormat::Packed)
+		GeneratePackedQuadVertices(sprites, 0, quadCount, (PackedQuadVertex*)m_Vertices.data());
+	else
+		GenerateQuadVertices(sprites, 0, quadCount, (QuadVertex*)m_Vertices.data());
+
+	// Reuse the storage while the batch fits in it, it only grows
+	if (!m_VertexBuffer || m_VertexBuffer->GetSize() < size)
+	{
+		m_VAO = std::make_unique<VertexArray>();
+		m_VertexBuffer = std::make_unique<VertexBuffer>(m_Vertices.data(), size);
+		m_VAO->AddBuffer(*m_VertexBuffer, Renderer2D::CreateVertexLayout(m_Format));
+	}
+	else if (size > 0)
+	{
+		m_VertexBuffer->Update(m_Vertices.data(), size);
+	}
+
+	if (quadCount > 0)
+	{
+		m_IndexBuffer = IndexBuffer::GetQuadIndexBuffer(quadCount);
+
+		m_Bounds = { m_PositionX[0], m_PositionY[0], m_PositionX[0] + m_Width[0], m_PositionY[0] + m_Height[0] };
+		for (unsigned int i = 1; i < quadCount; ++i)
+		{
+			m_Bounds.MinX = std::min(m_Bounds.MinX, m_PositionX[i]);
+			m_Bounds.MinY = std::min(m_Bounds.MinY, m_PositionY[i]);
+			m_Bounds.MaxX = std::max(m_Bounds.MaxX, m_PositionX[i] + m_Width[i]);
+			m_Bounds.MaxY = std::max(m_Bounds.MaxY, m_PositionY[i] + m_Height[i]);
+		}
+	}
+
+	m_BuiltGeneration = m_Generation;
+	m_BuildCount++;
+	return true;
+}
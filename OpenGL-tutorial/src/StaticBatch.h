@@ -0,0 +1,61 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "Renderer2D.h"
+
+// Retained list of quads whose vertices stay on the GPU between frames. Every edit that
+// changes a sprite bumps the generation; Build() regenerates and uploads the vertices only
+// when the generation moved since the last build, so static scenery costs nothing per frame.
+class StaticBatch
+{
+public:
+	// The format must match the Renderer2D the batch is drawn with
+	StaticBatch(Renderer2D::VertexFormat format = Renderer2D::VertexFormat::Float);
+	~StaticBatch();
+
+	// Return the index of the quad, for SetQuad
+	unsigned int AddQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color);
+	unsigned int AddQuad(const glm::vec2& position, const glm::vec2& size, const Texture& texture, const glm::vec4& tint = glm::vec4(1.0f));
+	// Only bumps the generation when a value actually changes
+	void SetQuad(unsigned int index, const glm::vec2& position, const glm::vec2& size, const glm::vec4& color);
+	void Clear();
+
+	// Returns true when the vertices had to be regenerated
+	bool Build();
+
+	inline unsigned int GetGeneration() const { return m_Generation; }
+	inline bool IsDirty() const { return m_Generation != m_BuiltGeneration; }
+	inline unsigned int GetQuadCount() const { return (unsigned int)m_PositionX.size(); }
+	inline unsigned int GetBuildCount() const { return m_BuildCount; }
+	inline Renderer2D::VertexFormat GetVertexFormat() const { return m_Format; }
+
+	// State of the last Build()
+	inline const VertexArray& GetVertexArray() const { return *m_VAO; }
+	inline const IndexBuffer& GetIndexBuffer() const { return *m_IndexBuffer; }
+	inline const std::vector<const Texture*>& GetTextures() const { return m_Textures; }  // texture i goes to unit i + 1
+	inline const CullRect& GetBounds() const { return m_Bounds; }
+
+private:
+	float GetTextureSlot(const Texture& texture);
+
+	Renderer2D::VertexFormat m_Format;
+	unsigned int m_Generation;
+	unsigned int m_BuiltGeneration;
+	unsigned int m_BuildCount;
+
+	// Sprites as structure-of-arrays, ready for the quad generators
+	std::vector<float> m_PositionX, m_PositionY, m_Width, m_Height;
+	std::vector<float> m_ColorR, m_ColorG, m_ColorB, m_ColorA;
+	std::vector<float> m_TexIndex;  // slot 0 is the white texture of the renderer
+	std::vector<const Texture*> m_Textures;
+
+	std::vector<unsigned char> m_Vertices;
+	std::unique_ptr<VertexArray> m_VAO;
+	std::unique_ptr<VertexBuffer> m_VertexBuffer;
+	std::shared_ptr<IndexBuffer> m_IndexBuffer;
+	CullRect m_Bounds;
+};
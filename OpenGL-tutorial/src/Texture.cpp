@@ -9,36 +9,67 @@ Texture::Texture(const std::string& path)
 	stbi_set_flip_vertically_on_load(1);
 	m_LocalBuffer = stbi_load(path.c_str(), &m_Width, &m_Height, &m_BPP, 4);
 
+	Create(m_LocalBuffer);
+
+	if (m_LocalBuffer != 0)
+	{
+		stbi_image_free(m_LocalBuffer);
+	}
+}
+
+Texture::Texture(int width, int height, const void* data)
+	: m_Filepath(), m_LocalBuffer(nullptr),
+	m_Width(width), m_Height(height), m_BPP(4)
+{
+	Create(data);
+}
+
+void Texture::Create(const void* data)
+{
+	if (Renderer::GetCapabilities().DirectStateAccess)
+	{
+		// Immutable storage, edited by name: no unit is disturbed
+		GLCall(glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID));
+		GLCall(glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+		GLCall(glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+		GLCall(glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+		GLCall(glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+
+		if (m_Width > 0 && m_Height > 0)  // an image that failed to load has no size
+		{
+			GLCall(glTextureStorage2D(m_RendererID, 1, GL_RGBA8, m_Width, m_Height));
+			if (data)
+			{
+				GLCall(glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, GL_RGBA, GL_UNSIGNED_BYTE, data));
+			}
+		}
+		return;
+	}
+
 	GLCall(glGenTextures(1, &m_RendererID));
-	GLCall(glBindTexture(GL_TEXTURE_2D, m_RendererID));
+	GLStateCache::BindTextureForEdit(m_RendererID);
 
 	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
 	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
 	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
 	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
 
-	GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_LocalBuffer));
-	GLCall(glBindTexture(GL_TEXTURE_2D, 0));
-
-	if (m_LocalBuffer != 0)
-	{
-		stbi_image_free(m_LocalBuffer);
-	}
+	GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data));
+	GLStateCache::BindTextureForEdit(0);
 }
 
-
 Texture::~Texture()
 {
 	GLCall(glDeleteTextures(1, &m_RendererID));
+	GLStateCache::OnTextureDeleted(m_RendererID);
 }
 
 void Texture::Bind(unsigned int slot) const
 {
-	GLCall(glActiveTexture(GL_TEXTURE0 + slot));
-	GLCall(glBindTexture(GL_TEXTURE_2D, m_RendererID));
+	GLStateCache::BindTexture(slot, m_RendererID);
 }
 
 void Texture::Unbind()
 {
-	GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+	GLStateCache::BindTextureForEdit(0);
 }
@@ -7,6 +7,7 @@ class Texture
 {
 public:
 	Texture(const std::string& path);
+	Texture(int width, int height, const void* data);  // RGBA8 pixels, e.g. generated at run time
 	~Texture();
 
 	void Bind(unsigned int slot = 0) const;
@@ -14,6 +15,7 @@ public:
 
 	inline int GetWidth() const { return m_Width; }
 	inline int GetHeight() const { return m_Height; }
+	inline unsigned int GetRendererID() const { return m_RendererID; }
 
 private:
 	unsigned int m_RendererID;
@@ -22,5 +24,7 @@ private:
 	int m_Width;
 	int m_Height;
 	int m_BPP;
+
+	void Create(const void* data);  // RGBA8 storage of m_Width x m_Height
 };
 
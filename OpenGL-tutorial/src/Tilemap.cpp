@@ -0,0 +1,149 @@
+#include "Tilemap.h"
+
+#include "Renderer.h"
+#include "VertexBufferLayout.h"
+
+#include <algorithm>
+
+Tilemap::Tilemap(unsigned int width, unsigned int height, float tileSize, const Texture& tileset,
+	unsigned int tilesetColumns, unsigned int tilesetRows, Renderer2D::VertexFormat format)
+	: m_Width(width), m_Height(height), m_TileSize(tileSize), m_Tileset(tileset),
+	m_TilesetColumns(tilesetColumns), m_TilesetRows(tilesetRows), m_Format(format),
+	m_Tiles(width * height, 0),
+	m_ChunkCountX((width + ChunkSize - 1) / ChunkSize), m_ChunkCountY((height + ChunkSize - 1) / ChunkSize),
+	m_MaxResidentChunks(1024), m_ChunkBuildCount(0)
+{
+	m_Chunks.resize(m_ChunkCountX * m_ChunkCountY);
+	m_IndexBuffer = IndexBuffer::GetQuadIndexBuffer(ChunkSize * ChunkSize);
+}
+
+Tilemap::~Tilemap()
+{
+}
+
+void Tilemap::SetTile(unsigned int x, unsigned int y, unsigned short tile)
+{
+	ASSERT(x < m_Width && y < m_Height);
+
+	unsigned short& current = m_Tiles[y * m_Width + x];
+	if (current == tile)
+		return;
+
+	current = tile;
+	m_Chunks[(y / ChunkSize) * m_ChunkCountX + x / ChunkSize].Dirty = true;
+}
+
+const Tilemap::Chunk& Tilemap::PrepareChunk(unsigned int chunkX, unsigned int chunkY, unsigned int frame)
+{
+	const unsigned int index = chunkY * m_ChunkCountX + chunkX;
+	Chunk& chunk = m_Chunks[index];
+	chunk.LastUsedFrame = frame;
+
+	if (chunk.Dirty)
+	{
+		if (!chunk.Buffer)
+		{
+			if (!m_Resident.empty() && m_Resident.size() >= m_MaxResidentChunks)
+				EvictChunk();
+			m_Resident.push_back(index);
+		}
+		BuildChunk(chunkX, chunkY, chunk);
+	}
+	return chunk;
+}
+
+void Tilemap::BuildChunk(unsigned int chunkX, unsigned int chunkY, Chunk& chunk)
+{
+	for (auto& array : m_Scratch)
+		array.resize(ChunkSize * ChunkSize);
+	float* x = m_Scratch[0].data();
+	float* y = m_Scratch[1].data();
+	float* u0 = m_Scratch[2].data();
+	float* v0 = m_Scratch[3].data();
+	float* u1 = m_Scratch[4].data();
+	float* v1 = m_Scratch[5].data();
+	float* sizes = m_Scratch[6].data();  // the same for every tile, the generators want an array
+
+	// Half a texel inside the cell, so that filtering never picks up the neighbouring tile
+	const float cellU = 1.0f / m_TilesetColumns, cellV = 1.0f / m_TilesetRows;
+	const float insetU = 0.5f / m_Tileset.GetWidth(), insetV = 0.5f / m_Tileset.GetHeight();
+
+	const unsigned int firstX = chunkX * ChunkSize, firstY = chunkY * ChunkSize;
+	const unsigned int endX = std::min(firstX + ChunkSize, m_Width), endY = std::min(firstY + ChunkSize, m_Height);
+	unsigned int count = 0;
+	for (unsigned int ty = firstY; ty < endY; ++ty)
+	{
+		for (unsigned int tx = firstX; tx < endX; ++tx)
+		{
+			const unsigned short tile = m_Tiles[ty * m_Width + tx];
+			if (tile == 0)
+				continue;  // empty tiles cost nothing
+
+			// Cells are counted from the top left, texture rows from the bottom
+			const unsigned int column = (tile - 1) % m_TilesetColumns;
+			const unsigned int row = m_TilesetRows - 1 - (tile - 1) / m_TilesetColumns % m_TilesetRows;
+			x[count] = tx * m_TileSize;
+			y[count] = ty * m_TileSize;
+			u0[count] = column * cellU + insetU;
+			v0[count] = row * cellV + insetV;
+			u1[count] = (column + 1) * cellU - insetU;
+			v1[count] = (row + 1) * cellV - insetV;
+			sizes[count] = m_TileSize;
+			count++;
+		}
+	}
+
+	QuadSpriteData sprites;
+	sprites.PositionX = x;
+	sprites.PositionY = y;
+	sprites.Width = sizes;
+	sprites.Height = sizes;
+	sprites.U0 = u0;
+	sprites.V0 = v0;
+	sprites.U1 = u1;
+	sprites.V1 = v1;
+	sprites.DefaultTexIndex = 1.0f;  // Renderer2D::DrawTilemap binds the tileset to unit 1
+
+	const unsigned int vertexSize = m_Format == Renderer2D::VertexFormat::Packed ? sizeof(PackedQuadVertex) : sizeof(QuadVertex);
+	const unsigned int size = ChunkSize * ChunkSize * 4 * vertexSize;
+	m_Vertices.resize(size);
+	if (m_Format == Renderer2D::VertexFormat::Packed)
+		GeneratePackedQuadVertices(sprites, 0, count, (PackedQuadVertex*)m_Vertices.data());
+	else
+		GenerateQuadVertices(sprites, 0, count, (QuadVertex*)m_Vertices.data());
+
+	// Sized for a full chunk, so edits never reallocate
+	if (!chunk.Buffer)
+	{
+		chunk.VAO = std::make_unique<VertexArray>();
+		chunk.Buffer = std::make_unique<VertexBuffer>(m_Vertices.data(), size);
+		chunk.VAO->AddBuffer(*chunk.Buffer, Renderer2D::CreateVertexLayout(m_Format));
+	}
+	else if (count > 0)
+	{
+		chunk.Buffer->Update(m_Vertices.data(), count * 4 * vertexSize);
+	}
+
+	chunk.QuadCount = count;
+	chunk.Dirty = false;
+	m_ChunkBuildCount++;
+}
+
+void Tilemap::EvictChunk()
+{
+	size_t oldest = 0;
+	for (size_t i = 1; i < m_Resident.size(); ++i)
+	{
+		if (m_Chunks[m_Resident[i]].LastUsedFrame < m_Chunks[m_Resident[oldest]].LastUsedFrame)
+			oldest = i;
+	}
+
+	Chunk& chunk = m_Chunks[m_Resident[oldest]];
+	chunk.VAO = nullptr;
+	chunk.Buffer = nullptr;
+	chunk.QuadCount = 0;
+	chunk.Dirty = true;  // rebuilt from the tiles when it is needed again
+
+	m_Resident[oldest] = m_Resident.back();
+	m_Resident.pop_back();
+}
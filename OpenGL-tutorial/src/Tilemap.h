@@ -0,0 +1,72 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Renderer2D.h"
+
+// Tile map split in ChunkSize x ChunkSize chunks. A chunk's vertices are generated once into
+// its own static vertex buffer, when it first becomes visible, and again only after one of
+// its tiles changes. Renderer2D::DrawTilemap draws the chunks that intersect the view, so
+// the cost follows the screen area rather than the map size.
+class Tilemap
+{
+public:
+	static const unsigned int ChunkSize = 32;
+
+	struct Chunk
+	{
+		std::unique_ptr<VertexArray> VAO;
+		std::unique_ptr<VertexBuffer> Buffer;
+		unsigned int QuadCount = 0;
+		bool Dirty = true;
+		unsigned int LastUsedFrame = 0;
+	};
+
+	// Tile t > 0 shows cell t - 1 of the tileset (row by row from the top left), 0 is empty.
+	// The format must match the Renderer2D the map is drawn with.
+	Tilemap(unsigned int width, unsigned int height, float tileSize, const Texture& tileset,
+		unsigned int tilesetColumns, unsigned int tilesetRows, Renderer2D::VertexFormat format = Renderer2D::VertexFormat::Float);
+	~Tilemap();
+
+	void SetTile(unsigned int x, unsigned int y, unsigned short tile);  // marks only its chunk dirty
+	inline unsigned short GetTile(unsigned int x, unsigned int y) const { return m_Tiles[y * m_Width + x]; }
+
+	// Builds the chunk if it is dirty or not resident, may evict the least recently used one
+	const Chunk& PrepareChunk(unsigned int chunkX, unsigned int chunkY, unsigned int frame);
+
+	inline unsigned int GetWidth() const { return m_Width; }
+	inline unsigned int GetHeight() const { return m_Height; }
+	inline unsigned int GetChunkCountX() const { return m_ChunkCountX; }
+	inline unsigned int GetChunkCountY() const { return m_ChunkCountY; }
+	inline float GetTileSize() const { return m_TileSize; }
+	inline const Texture& GetTileset() const { return m_Tileset; }
+	inline const IndexBuffer& GetIndexBuffer() const { return *m_IndexBuffer; }
+	inline Renderer2D::VertexFormat GetVertexFormat() const { return m_Format; }
+
+	// Chunks with vertex buffers are capped, the ones not drawn for the longest are released first
+	inline void SetMaxResidentChunks(unsigned int count) { m_MaxResidentChunks = count; }
+	inline unsigned int GetResidentChunkCount() const { return (unsigned int)m_Resident.size(); }
+	inline unsigned int GetChunkBuildCount() const { return m_ChunkBuildCount; }
+
+private:
+	void BuildChunk(unsigned int chunkX, unsigned int chunkY, Chunk& chunk);
+	void EvictChunk();
+
+	unsigned int m_Width, m_Height;
+	float m_TileSize;
+	const Texture& m_Tileset;
+	unsigned int m_TilesetColumns, m_TilesetRows;
+	Renderer2D::VertexFormat m_Format;
+
+	std::vector<unsigned short> m_Tiles;
+	unsigned int m_ChunkCountX, m_ChunkCountY;
+	std::vector<Chunk> m_Chunks;
+	std::vector<unsigned int> m_Resident;  // indices of the chunks that have a vertex buffer
+	unsigned int m_MaxResidentChunks;
+	unsigned int m_ChunkBuildCount;
+
+	std::shared_ptr<IndexBuffer> m_IndexBuffer;
+	std::vector<float> m_Scratch[7];  // SoA sprites of the chunk being built
+	std::vector<unsigned char> m_Vertices;
+};
@@ -0,0 +1,39 @@
+#include "UniformBuffer.h"
+#include "Renderer.h"
+
+UniformBuffer::UniformBuffer(unsigned int size, unsigned int binding)
+	: m_Size(size), m_Binding(binding)
+{
+	if (Renderer::GetCapabilities().DirectStateAccess)
+	{
+		GLCall(glCreateBuffers(1, &m_RendererID));
+		GLCall(glNamedBufferData(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW));
+	}
+	else
+	{
+		GLCall(glGenBuffers(1, &m_RendererID));
+		GLStateCache::BindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+		GLCall(glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW));
+	}
+	GLStateCache::BindBufferBase(GL_UNIFORM_BUFFER, m_Binding, m_RendererID);
+}
+
+UniformBuffer::~UniformBuffer()
+{
+	GLCall(glDeleteBuffers(1, &m_RendererID));
+	GLStateCache::OnBufferDeleted(m_RendererID);
+}
+
+void UniformBuffer::SetData(const void* data, unsigned int size, unsigned int offset)
+{
+	ASSERT(offset + size <= m_Size);
+
+	if (Renderer::GetCapabilities().DirectStateAccess)
+	{
+		GLCall(glNamedBufferSubData(m_RendererID, offset, size, data));
+		return;
+	}
+
+	GLStateCache::BindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+	GLCall(glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data));
+}
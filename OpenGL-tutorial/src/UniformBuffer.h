@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+
+#include "glm/glm.hpp"
+
+// Binding points of the uniform blocks every shader shares. Shader binds a block to its
+// point by name after linking, so the GLSL side needs no binding qualifier.
+enum class UniformBinding : unsigned int
+{
+	Camera = 0  // block "Camera"
+};
+
+// Mirror of the std140 block
+//   layout(std140) uniform Camera { mat4 u_View; mat4 u_Projection; mat4 u_ViewProjection; };
+// std140 puts a mat4 as four vec4 columns on 16-byte boundaries, which is glm's layout too.
+struct CameraUniforms
+{
+	glm::mat4 View;
+	glm::mat4 Projection;
+	glm::mat4 ViewProjection;  // Projection * View, so that shaders do not multiply it per vertex
+};
+
+static_assert(offsetof(CameraUniforms, View) == 0, "std140: u_View at 0");
+static_assert(offsetof(CameraUniforms, Projection) == 64, "std140: u_Projection at 64");
+static_assert(offsetof(CameraUniforms, ViewProjection) == 128, "std140: u_ViewProjection at 128");
+static_assert(sizeof(CameraUniforms) == 192, "std140: the Camera block is 192 bytes");
+
+// GL_UNIFORM_BUFFER attached to a fixed binding point for its whole life
+class UniformBuffer
+{
+private:
+	unsigned int m_RendererID;
+	unsigned int m_Size;
+	unsigned int m_Binding;
+
+public:
+	UniformBuffer(unsigned int size, unsigned int binding);
+	~UniformBuffer();
+
+	void SetData(const void* data, unsigned int size, unsigned int offset = 0);
+
+	inline unsigned int GetID() const { return m_RendererID; }
+	inline unsigned int GetSize() const { return m_Size; }
+	inline unsigned int GetBinding() const { return m_Binding; }
+};
@@ -4,38 +4,135 @@
 #include "Renderer.h"
 
 VertexArray::VertexArray()
+	: m_AttributeCount(0), m_BindingCount(0), m_BaseInstance(0)
 {
-	GLCall(glGenVertexArrays(1, &m_RendereID));
+	// glCreate gives an object right away, a glGen name only becomes one when first bound
+	if (Renderer::GetCapabilities().DirectStateAccess)
+	{
+		GLCall(glCreateVertexArrays(1, &m_RendereID));
+	}
+	else
+	{
+		GLCall(glGenVertexArrays(1, &m_RendereID));
+	}
 }
 
 VertexArray::~VertexArray()
 {
 	GLCall(glDeleteVertexArrays(1, &m_RendereID));
+	GLStateCache::OnVertexArrayDeleted(m_RendereID);
 }
 
 void VertexArray::AddBuffer(const VertexBuffer & vb, const VertexBufferLayout & layout)
 {
+	if (layout.GetDivisor() != 0)
+	{
+		// Remembered in case a draw has to start past the first instance without base instance support
+		InstancedBuffer buffer = { vb.GetID(), m_BindingCount, layout.GetStride(), {} };
+		const auto& elements = layout.GetElements();
+		for (unsigned int i = 0; i < elements.size(); ++i)
+		{
+			const auto& element = elements[i];
+			buffer.Attributes.push_back({ m_AttributeCount + i, element.type, element.count, element.offset, element.normalized, element.integer });
+		}
+		m_InstancedBuffers.push_back(buffer);
+	}
+
+	if (Renderer::GetCapabilities().DirectStateAccess)
+	{
+		AddBufferNamed(vb, layout);
+		return;
+	}
+
 	Bind();
 	vb.Bind();
 	const auto& elements = layout.GetElements();
-	unsigned int offset = 0;
 
 	for (unsigned int i = 0; i < elements.size(); ++i)
 	{
 		const auto& element = elements[i];
-		GLCall(glEnableVertexAttribArray(i));
-		GLCall(glVertexAttribPointer(i, element.count, element.type,
-			element.normalized, layout.GetStride(), (const void *)offset));
-		offset += element.count * VertexBufferElement::GetSizeOfType(element.type);
+		const unsigned int index = m_AttributeCount + i;
+		GLCall(glEnableVertexAttribArray(index));
+		if (element.integer)
+		{
+			GLCall(glVertexAttribIPointer(index, element.count, element.type,
+				layout.GetStride(), (const void *)(size_t)element.offset));
+		}
+		else
+		{
+			GLCall(glVertexAttribPointer(index, element.count, element.type,
+				element.normalized, layout.GetStride(), (const void *)(size_t)element.offset));
+		}
+		GLCall(glVertexAttribDivisor(index, layout.GetDivisor()));
+	}
+	m_AttributeCount += (unsigned int)elements.size();
+}
+
+void VertexArray::AddBufferNamed(const VertexBuffer & vb, const VertexBufferLayout & layout)
+{
+	// Each buffer gets its own binding point, which holds the stride and the divisor
+	const unsigned int binding = m_BindingCount++;
+	GLCall(glVertexArrayVertexBuffer(m_RendereID, binding, vb.GetID(), 0, layout.GetStride()));
+	GLCall(glVertexArrayBindingDivisor(m_RendereID, binding, layout.GetDivisor()));
+
+	const auto& elements = layout.GetElements();
+	for (unsigned int i = 0; i < elements.size(); ++i)
+	{
+		const auto& element = elements[i];
+		const unsigned int index = m_AttributeCount + i;
+		GLCall(glEnableVertexArrayAttrib(m_RendereID, index));
+		if (element.integer)
+		{
+			GLCall(glVertexArrayAttribIFormat(m_RendereID, index, element.count, element.type, element.offset));
+		}
+		else
+		{
+			GLCall(glVertexArrayAttribFormat(m_RendereID, index, element.count, element.type, element.normalized, element.offset));
+		}
+		GLCall(glVertexArrayAttribBinding(m_RendereID, index, binding));
+	}
+	m_AttributeCount += (unsigned int)elements.size();
+}
+
+void VertexArray::SetBaseInstance(unsigned int baseInstance) const
+{
+	Bind();
+	if (baseInstance == m_BaseInstance)
+		return;
+	m_BaseInstance = baseInstance;
+
+	for (const InstancedBuffer& buffer : m_InstancedBuffers)
+	{
+		const size_t base = (size_t)baseInstance * buffer.Stride;
+		if (Renderer::GetCapabilities().DirectStateAccess)
+		{
+			GLCall(glVertexArrayVertexBuffer(m_RendereID, buffer.Binding, buffer.BufferID, (GLintptr)base, buffer.Stride));
+			continue;
+		}
+
+		GLStateCache::BindBuffer(GL_ARRAY_BUFFER, buffer.BufferID);
+		for (const InstancedAttribute& attribute : buffer.Attributes)
+		{
+			if (attribute.Integer)
+			{
+				GLCall(glVertexAttribIPointer(attribute.Index, attribute.Count, attribute.Type,
+					buffer.Stride, (const void *)(base + attribute.Offset)));
+			}
+			else
+			{
+				GLCall(glVertexAttribPointer(attribute.Index, attribute.Count, attribute.Type,
+					attribute.Normalized, buffer.Stride, (const void *)(base + attribute.Offset)));
+			}
+		}
 	}
 }
 
 void VertexArray::Bind() const
 {
-	GLCall(glBindVertexArray(m_RendereID));
+	GLStateCache::BindVertexArray(m_RendereID);
 }
 
 void VertexArray::Unbind() const
 {
-	GLCall(glBindVertexArray(0));
+	GLStateCache::BindVertexArray(0);
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "VertexBuffer.h"
 
 class VertexBufferLayout;
@@ -7,14 +9,47 @@ class VertexBufferLayout;
 class VertexArray
 {
 private:
+	// What it takes to point the attributes of an instance-rate buffer somewhere else
+	struct InstancedAttribute
+	{
+		unsigned int Index;
+		unsigned int Type;
+		unsigned int Count;
+		unsigned int Offset;
+		unsigned char Normalized;
+		bool Integer;
+	};
+
+	struct InstancedBuffer
+	{
+		unsigned int BufferID;
+		unsigned int Binding;  // direct state access
+		unsigned int Stride;
+		std::vector<InstancedAttribute> Attributes;
+	};
+
 	unsigned int m_RendereID;
+	unsigned int m_AttributeCount;  // attribute index used by the next buffer
+	unsigned int m_BindingCount;    // vertex buffer binding point used by the next buffer (direct state access)
+	std::vector<InstancedBuffer> m_InstancedBuffers;
+	mutable unsigned int m_BaseInstance;
+
+	void AddBufferNamed(const VertexBuffer& vb, const VertexBufferLayout& layout);
 
 public:
 	VertexArray();
 	~VertexArray();
 
+	// Buffers added one after the other use consecutive attribute indices
 	void AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout);
 
 	void Bind() const;
 	void Unbind() const;
+
+	// Makes the instance-rate attributes start at instance baseInstance by offsetting their
+	// buffers, what the baseinstance argument of a draw does on GL 4.2 / ARB_base_instance.
+	// Binds the vertex array. Set it back to 0 after the draws that needed it.
+	void SetBaseInstance(unsigned int baseInstance) const;
+
+	inline unsigned int GetRendererID() const { return m_RendereID; }
 };
\ No newline at end of file
@@ -1,24 +1,328 @@
 #include "VertexBuffer.h"
 #include "Renderer.h"
 
+#include <algorithm>
+#include <cstring>
+
 VertexBuffer::VertexBuffer(const void * data, unsigned int size)
+	: m_Size(size), m_Usage(BufferUsage::Dynamic), m_RegionSize(size), m_RegionCount(1), m_CurrentRegion(0),
+	m_RegionInUse(false), m_MappedData(nullptr), m_StallCount(0), m_UpdateStrategy(BufferUpdateStrategy::SubData),
+	m_MergeThreshold(256), m_UploadCount(0), m_UploadedBytes(0)
 {
+	if (Renderer::GetCapabilities().DirectStateAccess)
+	{
+		GLCall(glCreateBuffers(1, &m_RendererID));
+		GLCall(glNamedBufferData(m_RendererID, size, data, GL_DYNAMIC_DRAW));
+		return;
+	}
+
 	GLCall(glGenBuffers(1, &m_RendererID));	// Create a buffer and returns the buffer id
-	GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+	GLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 	GLCall(glBufferData(GL_ARRAY_BUFFER, size, data, GL_DYNAMIC_DRAW));	// Put data in the buffer
 }
 
+VertexBuffer::VertexBuffer(unsigned int size, BufferUsage usage, unsigned int regionCount)
+	: m_Size(size), m_Usage(usage), m_RegionSize(size), m_RegionCount(1), m_CurrentRegion(0),
+	m_RegionInUse(false), m_MappedData(nullptr), m_StallCount(0), m_UpdateStrategy(BufferUpdateStrategy::SubData),
+	m_MergeThreshold(256), m_UploadCount(0), m_UploadedBytes(0)
+{
+	const bool dsa = Renderer::GetCapabilities().DirectStateAccess;
+	if (dsa)
+	{
+		GLCall(glCreateBuffers(1, &m_RendererID));
+	}
+	else
+	{
+		GLCall(glGenBuffers(1, &m_RendererID));
+		GLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+	}
+
+	if (usage == BufferUsage::Dynamic)
+	{
+		if (dsa)
+		{
+			GLCall(glNamedBufferData(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW));
+		}
+		else
+		{
+			GLCall(glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW));
+		}
+		return;
+	}
+
+	m_RegionCount = regionCount;
+	m_Size = m_RegionSize * m_RegionCount;
+	m_Fences.resize(m_RegionCount, nullptr);
+
+	if (Renderer::GetCapabilities().BufferStorage)
+	{
+		// Immutable storage mapped once for the lifetime of the buffer. Coherent mapping:
+		// CPU writes become visible to the GPU without explicit flushes.
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		if (dsa)
+		{
+			GLCall(glNamedBufferStorage(m_RendererID, m_Size, nullptr, flags));
+			GLCall(m_MappedData = (unsigned char*)glMapNamedBufferRange(m_RendererID, 0, m_Size, flags));
+		}
+		else
+		{
+			GLCall(glBufferStorage(GL_ARRAY_BUFFER, m_Size, nullptr, flags));
+			GLCall(m_MappedData = (unsigned char*)glMapBufferRange(GL_ARRAY_BUFFER, 0, m_Size, flags));
+		}
+	}
+	else
+	{
+		if (dsa)
+		{
+			GLCall(glNamedBufferData(m_RendererID, m_Size, nullptr, GL_STREAM_DRAW));
+		}
+		else
+		{
+			GLCall(glBufferData(GL_ARRAY_BUFFER, m_Size, nullptr, GL_STREAM_DRAW));
+		}
+		m_Staging.resize(m_RegionSize);
+	}
+}
+
 VertexBuffer::~VertexBuffer()
 {
+	for (GLsync fence : m_Fences)
+	{
+		if (fence)
+		{
+			GLCall(glDeleteSync(fence));
+		}
+	}
+
+	if (m_MappedData)
+	{
+		if (Renderer::GetCapabilities().DirectStateAccess)
+		{
+			GLCall(glUnmapNamedBuffer(m_RendererID));
+		}
+		else
+		{
+			GLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+			GLCall(glUnmapBuffer(GL_ARRAY_BUFFER));
+		}
+	}
+
 	GLCall(glDeleteBuffers(1, &m_RendererID));
+	GLStateCache::OnBufferDeleted(m_RendererID);
 }
 
 void VertexBuffer::Bind() const
 {
-	GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+	GLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 }
 
 void VertexBuffer::Unbind() const
 {
-	GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+	GLStateCache::BindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void* VertexBuffer::BeginRegion()
+{
+	ASSERT(m_Usage == BufferUsage::Streaming);
+
+	if (m_RegionInUse)
+	{
+		// The draws reading the current region have been issued: fence it and move on
+		GLCall(m_Fences[m_CurrentRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+		m_CurrentRegion = (m_CurrentRegion + 1) % m_RegionCount;
+		m_RegionInUse = false;
+	}
+
+	GLsync& fence = m_Fences[m_CurrentRegion];
+	if (fence)
+	{
+		GLCall(GLenum result = glClientWaitSync(fence, 0, 0));
+		if (result == GL_TIMEOUT_EXPIRED)
+		{
+			m_StallCount++;
+			do
+			{
+				GLCall(result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000));  // 1 ms
+			} while (result == GL_TIMEOUT_EXPIRED);
+		}
+		GLCall(glDeleteSync(fence));
+		fence = nullptr;
+	}
+
+	if (m_MappedData)
+		return m_MappedData + GetRegionOffset();
+	return m_Staging.data();
+}
+
+void VertexBuffer::EndRegion(unsigned int size)
+{
+	ASSERT(m_Usage == BufferUsage::Streaming && size <= m_RegionSize);
+
+	if (!m_MappedData && size > 0)
+	{
+		if (Renderer::GetCapabilities().DirectStateAccess)
+		{
+			GLCall(glNamedBufferSubData(m_RendererID, GetRegionOffset(), size, m_Staging.data()));
+		}
+		else
+		{
+			Bind();
+			GLCall(glBufferSubData(GL_ARRAY_BUFFER, GetRegionOffset(), size, m_Staging.data()));
+		}
+	}
+	m_RegionInUse = true;
+}
+
+void VertexBuffer::Update(const void* data, unsigned int size, unsigned int offset)
+{
+	Update(data, size, offset, m_UpdateStrategy);
+}
+
+void VertexBuffer::Update(const void* data, unsigned int size, unsigned int offset, BufferUpdateStrategy strategy)
+{
+	ASSERT(m_Usage == BufferUsage::Dynamic && offset + size <= m_Size);
+
+	if (Renderer::GetCapabilities().DirectStateAccess)
+	{
+		UpdateNamed(data, size, offset, strategy);
+		return;
+	}
+
+	Bind();
+	switch (strategy)
+	{
+	case BufferUpdateStrategy::SubData:
+		GLCall(glBufferSubData(GL_ARRAY_BUFFER, offset, size, data));
+		break;
+
+	case BufferUpdateStrategy::Orphaning:
+		// The driver hands out fresh storage while the GPU keeps the old one, so
+		// whatever is outside [offset, offset + size) is undefined afterwards.
+		GLCall(glBufferData(GL_ARRAY_BUFFER, m_Size, nullptr, GL_DYNAMIC_DRAW));
+		GLCall(glBufferSubData(GL_ARRAY_BUFFER, offset, size, data));
+		break;
+
+	case BufferUpdateStrategy::MapUnsynchronized:
+	{
+		const GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+		GLCall(void* ptr = glMapBufferRange(GL_ARRAY_BUFFER, offset, size, access));
+		if (ptr)
+		{
+			memcpy(ptr, data, size);
+			GLCall(glUnmapBuffer(GL_ARRAY_BUFFER));
+		}
+		break;
+	}
+	}
+}
+
+void VertexBuffer::UpdateNamed(const void* data, unsigned int size, unsigned int offset, BufferUpdateStrategy strategy)
+{
+	switch (strategy)
+	{
+	case BufferUpdateStrategy::SubData:
+		GLCall(glNamedBufferSubData(m_RendererID, offset, size, data));
+		break;
+
+	case BufferUpdateStrategy::Orphaning:
+		GLCall(glNamedBufferData(m_RendererID, m_Size, nullptr, GL_DYNAMIC_DRAW));
+		GLCall(glNamedBufferSubData(m_RendererID, offset, size, data));
+		break;
+
+	case BufferUpdateStrategy::MapUnsynchronized:
+	{
+		const GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+		GLCall(void* ptr = glMapNamedBufferRange(m_RendererID, offset, size, access));
+		if (ptr)
+		{
+			memcpy(ptr, data, size);
+			GLCall(glUnmapNamedBuffer(m_RendererID));
+		}
+		break;
+	}
+	}
+}
+
+void VertexBuffer::EnableShadowCopy(unsigned int mergeThreshold)
+{
+	ASSERT(m_Usage == BufferUsage::Dynamic);
+
+	m_Shadow.assign(m_Size, 0);
+	m_MergeThreshold = mergeThreshold;
+
+	// The GPU copy is unknown to the shadow: the first flush makes them match
+	m_DirtyRanges.clear();
+	m_DirtyRanges.push_back({ 0, m_Size });
+}
+
+void VertexBuffer::Write(unsigned int offset, const void* data, unsigned int size)
+{
+	ASSERT(!m_Shadow.empty() && offset + size <= m_Size);
+
+	unsigned char* shadow = m_Shadow.data() + offset;
+	const unsigned char* source = (const unsigned char*)data;
+
+	// Trim the bytes that are already in the buffer at both ends
+	unsigned int begin = 0;
+	while (begin < size && shadow[begin] == source[begin])
+		begin++;
+	if (begin == size)
+		return;
+
+	unsigned int end = size;
+	while (shadow[end - 1] == source[end - 1])
+		end--;
+
+	memcpy(shadow + begin, source + begin, end - begin);
+	m_DirtyRanges.push_back({ offset + begin, offset + end });
+}
+
+void VertexBuffer::FlushWrites()
+{
+	ASSERT(!m_Shadow.empty());
+
+	if (m_DirtyRanges.empty())
+		return;
+
+	// Orphaning throws away the bytes outside of the upload, only a full upload keeps them
+	bool wholeBuffer = m_UpdateStrategy == BufferUpdateStrategy::Orphaning;
+
+	std::vector<std::pair<unsigned int, unsigned int>> merged;
+	if (!wholeBuffer)
+	{
+		std::sort(m_DirtyRanges.begin(), m_DirtyRanges.end());
+
+		// A gap cheaper to send than a separate call joins its neighbours
+		merged.push_back(m_DirtyRanges[0]);
+		for (size_t i = 1; i < m_DirtyRanges.size(); ++i)
+		{
+			auto& last = merged.back();
+			const auto& range = m_DirtyRanges[i];
+			if (range.first <= last.second + m_MergeThreshold)
+				last.second = std::max(last.second, range.second);
+			else
+				merged.push_back(range);
+		}
+
+		size_t cost = 0;
+		for (const auto& range : merged)
+			cost += range.second - range.first + m_MergeThreshold;
+		wholeBuffer = cost >= m_Size;
+	}
+
+	if (wholeBuffer)
+	{
+		merged.clear();
+		merged.push_back({ 0, m_Size });
+	}
+
+	for (const auto& range : merged)
+	{
+		const unsigned int size = range.second - range.first;
+		Update(m_Shadow.data() + range.first, size, range.first);
+		m_UploadCount++;
+		m_UploadedBytes += size;
+	}
+
+	m_DirtyRanges.clear();
 }
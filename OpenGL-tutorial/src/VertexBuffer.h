@@ -1,14 +1,92 @@
 #pragma once
 
+#include <utility>
+#include <vector>
+#include <GL/glew.h>
+
+enum class BufferUsage
+{
+	Dynamic,    // glBufferData storage, updated by the caller
+	Streaming   // ring of regions written by the CPU every frame, see BeginRegion
+};
+
+// How Update() sends new data to a Dynamic buffer. Drivers differ a lot in which one is fastest.
+enum class BufferUpdateStrategy
+{
+	SubData,           // glBufferSubData into the existing storage
+	Orphaning,         // glBufferData(nullptr) to detach the old storage, then glBufferSubData
+	MapUnsynchronized  // glMapBufferRange with INVALIDATE_RANGE | UNSYNCHRONIZED, then memcpy
+};
+
 class VertexBuffer
 {
 private:
 	unsigned int m_RendererID;
+	unsigned int m_Size;
+
+	// Streaming mode: the buffer is split into m_RegionCount regions of m_RegionSize bytes.
+	// Each region is protected by a fence so only a region still read by the GPU can block.
+	BufferUsage m_Usage;
+	unsigned int m_RegionSize;
+	unsigned int m_RegionCount;
+	unsigned int m_CurrentRegion;
+	bool m_RegionInUse;          // the current region has been handed to the GPU
+	std::vector<GLsync> m_Fences;
+	unsigned char* m_MappedData; // persistent mapping, nullptr when glBufferStorage is not available
+	std::vector<unsigned char> m_Staging;  // fallback: written by the CPU, uploaded with glBufferSubData
+	unsigned int m_StallCount;
+
+	BufferUpdateStrategy m_UpdateStrategy;
+
+	// Dynamic mode with a shadow copy: Write() records the bytes that really changed, FlushWrites() uploads them
+	std::vector<unsigned char> m_Shadow;
+	std::vector<std::pair<unsigned int, unsigned int>> m_DirtyRanges;  // [begin, end) byte ranges, unsorted
+	unsigned int m_MergeThreshold;
+	unsigned int m_UploadCount;
+	unsigned int m_UploadedBytes;
+
+	void UpdateNamed(const void* data, unsigned int size, unsigned int offset, BufferUpdateStrategy strategy);  // direct state access
+
 public:
 	VertexBuffer(const void *data, unsigned int size);
+	VertexBuffer(unsigned int size, BufferUsage usage, unsigned int regionCount = 3);  // size of one region when streaming
 	~VertexBuffer();
 
 	void Bind() const;
 	void Unbind() const;
 	unsigned int GetID() const { return m_RendererID; }
-};
\ No newline at end of file
+	inline unsigned int GetSize() const { return m_Size; }
+
+	// Dynamic mode only: replaces size bytes at offset with data using the current strategy.
+	// MapUnsynchronized is only safe when the range is not read by pending draws (or
+	// when the caller writes each frame to a different range).
+	void Update(const void* data, unsigned int size, unsigned int offset = 0);
+	void Update(const void* data, unsigned int size, unsigned int offset, BufferUpdateStrategy strategy);
+	inline void SetUpdateStrategy(BufferUpdateStrategy strategy) { m_UpdateStrategy = strategy; }
+	inline BufferUpdateStrategy GetUpdateStrategy() const { return m_UpdateStrategy; }
+
+	// Dynamic mode only. Keeps a CPU copy of the buffer so that Write() can compare against it
+	// and only mark the bytes that differ. The whole buffer is marked dirty (and reset to zero).
+	// mergeThreshold is the cost of one upload call expressed in bytes: dirty ranges closer than
+	// that are merged, and the whole buffer is sent once the ranges would cost more than that.
+	void EnableShadowCopy(unsigned int mergeThreshold = 256);
+	void Write(unsigned int offset, const void* data, unsigned int size);
+	void FlushWrites();
+	inline bool HasShadowCopy() const { return !m_Shadow.empty(); }
+	inline void SetMergeThreshold(unsigned int bytes) { m_MergeThreshold = bytes; }
+	inline unsigned int GetMergeThreshold() const { return m_MergeThreshold; }
+
+	// Calls and bytes sent by FlushWrites since the last reset
+	inline unsigned int GetUploadCount() const { return m_UploadCount; }
+	inline unsigned int GetUploadedBytes() const { return m_UploadedBytes; }
+	inline void ResetUploadStats() { m_UploadCount = 0; m_UploadedBytes = 0; }
+
+	// Streaming mode only. BeginRegion returns a pointer to the next free region, waiting
+	// only if the GPU still reads it. EndRegion makes the first size bytes visible to the
+	// GPU; draws that read them must be issued before the next BeginRegion.
+	void* BeginRegion();
+	void EndRegion(unsigned int size);
+	inline unsigned int GetRegionOffset() const { return m_CurrentRegion * m_RegionSize; }
+	inline bool IsPersistentlyMapped() const { return m_MappedData != nullptr; }
+	inline unsigned int GetStallCount() const { return m_StallCount; }  // times BeginRegion had to wait for the GPU
+};
@@ -10,18 +10,37 @@ struct VertexBufferElement
 	unsigned int type;
 	unsigned int count;
 	unsigned char normalized;
+	bool integer;         // read as int/uint in the shader (glVertexAttribIPointer) instead of converted to float
+	unsigned int offset;  // from the start of the vertex
 
 	static unsigned int GetSizeOfType(unsigned int type)
 	{
 		switch (type)
 		{
-			case GL_FLOAT:			return 4;
-			case GL_UNSIGNED_INT:	return 4;
-			case GL_UNSIGNED_BYTE:	return 1;
+			case GL_FLOAT:						return 4;
+			case GL_UNSIGNED_INT:				return 4;
+			case GL_INT:						return 4;
+			case GL_UNSIGNED_BYTE:				return 1;
+			case GL_BYTE:						return 1;
+			case GL_HALF_FLOAT:					return 2;
+			case GL_SHORT:						return 2;
+			case GL_UNSIGNED_SHORT:				return 2;
+			case GL_INT_2_10_10_10_REV:			return 4;  // all 4 components in one word
+			case GL_UNSIGNED_INT_2_10_10_10_REV:	return 4;
 		}
 		ASSERT(false);
 		return 0;
 	}
+
+	static bool IsPackedType(unsigned int type)
+	{
+		return type == GL_INT_2_10_10_10_REV || type == GL_UNSIGNED_INT_2_10_10_10_REV;
+	}
+
+	unsigned int GetSize() const
+	{
+		return IsPackedType(type) ? GetSizeOfType(type) : count * GetSizeOfType(type);
+	}
 };
 
 class VertexBufferLayout
@@ -29,10 +48,12 @@ class VertexBufferLayout
 private:
 	std::vector<VertexBufferElement> m_Elements;
 	unsigned int m_Stride;
+	unsigned int m_Divisor;
 
 public:
-	VertexBufferLayout()
-		:m_Stride(0) {}
+	// divisor 0: the attributes advance per vertex, N: they advance once every N instances
+	VertexBufferLayout(unsigned int divisor = 0)
+		:m_Stride(0), m_Divisor(divisor) {}
 
 	template<typename T>
 	void Push(unsigned int count)
@@ -43,25 +64,74 @@ public:
 	template<>
 	void Push<float>(unsigned int count)
 	{
-		m_Elements.push_back({ GL_FLOAT, count, GL_FALSE });
-		m_Stride += count * VertexBufferElement::GetSizeOfType(GL_FLOAT);
+		PushElement({ GL_FLOAT, count, GL_FALSE, false });
 	}
 
 	template<>
 	void Push<unsigned int>(unsigned int count)
 	{
-		m_Elements.push_back({ GL_UNSIGNED_INT, count, GL_FALSE });
-		m_Stride += count * VertexBufferElement::GetSizeOfType(GL_UNSIGNED_INT);
+		PushElement({ GL_UNSIGNED_INT, count, GL_FALSE, false });
 	}
 
 	template<>
 	void Push<unsigned char>(unsigned int count)
 	{
-		m_Elements.push_back({ GL_UNSIGNED_BYTE, count, GL_TRUE });
-		m_Stride += count * VertexBufferElement::GetSizeOfType(GL_UNSIGNED_BYTE);
+		PushElement({ GL_UNSIGNED_BYTE, count, GL_TRUE, false });
+	}
+
+	// Normalized to [0, 1] like the bytes
+	template<>
+	void Push<unsigned short>(unsigned int count)
+	{
+		PushElement({ GL_UNSIGNED_SHORT, count, GL_TRUE, false });
+	}
+
+	// Normalized to [-1, 1]
+	template<>
+	void Push<short>(unsigned int count)
+	{
+		PushElement({ GL_SHORT, count, GL_TRUE, false });
+	}
+
+	// 16-bit floats, stored as the raw bits (see FloatToHalf)
+	void PushHalf(unsigned int count)
+	{
+		PushElement({ GL_HALF_FLOAT, count, GL_FALSE, false });
+	}
+
+	// x, y, z in 10 bits each and w in 2 bits, packed in one 32-bit word
+	void PushPacked(bool normalized = true, bool isSigned = true)
+	{
+		if (isSigned)
+			PushElement({ GL_INT_2_10_10_10_REV, 4, (unsigned char)normalized, false });
+		else
+			PushElement({ GL_UNSIGNED_INT_2_10_10_10_REV, 4, (unsigned char)normalized, false });
+	}
+
+	// Integer types kept as integers in the shader (int/uint/ivecN/uvecN inputs)
+	void PushInteger(unsigned int type, unsigned int count)
+	{
+		ASSERT(type == GL_BYTE || type == GL_UNSIGNED_BYTE || type == GL_SHORT ||
+			type == GL_UNSIGNED_SHORT || type == GL_INT || type == GL_UNSIGNED_INT);
+		PushElement({ type, count, GL_FALSE, true });
+	}
+
+	// Unused bytes, keeps the next attribute (or the next vertex) aligned to the struct it mirrors
+	void PushPadding(unsigned int bytes)
+	{
+		m_Stride += bytes;
 	}
 
 	inline const std::vector<VertexBufferElement>& GetElements() const { return m_Elements; }
 	inline unsigned int GetStride() const { return m_Stride; }
+	inline unsigned int GetDivisor() const { return m_Divisor; }
+
+private:
+	void PushElement(VertexBufferElement element)
+	{
+		element.offset = m_Stride;
+		m_Elements.push_back(element);
+		m_Stride += element.GetSize();
+	}
 };
 
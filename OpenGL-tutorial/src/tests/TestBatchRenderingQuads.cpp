@@ -26,13 +26,8 @@ namespace test {
 			 400.0f, -100.0f,
 		};
 
-		unsigned int indices[] = {  // You must use an unsigned type
-			0, 1, 2, 2, 3, 0,  // indices for one quad
-			4, 5, 6, 6, 7, 4
-		};
-
-		GLCall(glEnable(GL_BLEND));
-		GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+		GLStateCache::SetBlendEnabled(true);
+		GLStateCache::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 		m_VAO = std::make_unique<VertexArray>();
 
@@ -41,11 +36,13 @@ namespace test {
 		layout.Push<float>(2);
 		m_VAO->AddBuffer(*m_VertexBuffer, layout);
 
-		m_IndexBuffer = std::make_unique<IndexBuffer>(indices, 12);
+		m_IndexBuffer = IndexBuffer::GetQuadIndexBuffer(2);  // shared 0, 1, 2, 2, 3, 0 pattern
 
 		m_Shader = std::make_unique<Shader>("res/shaders/BatchRendering.shader");
+		m_ModelUniform = m_Shader->GetUniformHandle("u_Model");
+		m_ColorUniform = m_Shader->GetUniformHandle("u_Color");
 		m_Shader->Bind();
-		m_Shader->SetUniform4f("u_Color", m_QuadsColor[0], m_QuadsColor[1], m_QuadsColor[2], m_QuadsColor[3]);
+		m_Shader->SetUniform4f(m_ColorUniform, m_QuadsColor[0], m_QuadsColor[1], m_QuadsColor[2], m_QuadsColor[3]);
 	}
 
 
@@ -59,19 +56,19 @@ namespace test {
 
 	void TestBatchRenderingQuads::OnRender()
 	{
-		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLStateCache::SetClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 		GLCall(glClear(GL_COLOR_BUFFER_BIT));
 
 		Renderer renderer;
+		Renderer::SetCamera(m_View, m_Proj);  // once, every draw below reads it
 
 		{
 			glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(200, 200, 0));
-			glm::mat4 mvp = m_Proj * m_View * model;  // the order is important!
 			m_Shader->Bind();
-			m_Shader->SetUniformMat4f("u_MVP", mvp);
-			m_Shader->SetUniform4f("u_Color", m_QuadsColor[0], m_QuadsColor[1], m_QuadsColor[2], m_QuadsColor[3]);
+			m_Shader->SetUniformMat4f(m_ModelUniform, model);
+			m_Shader->SetUniform4f(m_ColorUniform, m_QuadsColor[0], m_QuadsColor[1], m_QuadsColor[2], m_QuadsColor[3]);
 
-			renderer.Draw(*m_VAO, *m_IndexBuffer, *m_Shader);
+			renderer.Draw(*m_VAO, *m_IndexBuffer, *m_Shader, 2 * 6);  // 2 quads
 		}
 	}
 
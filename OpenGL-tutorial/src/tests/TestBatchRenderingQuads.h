@@ -23,8 +23,10 @@ namespace test {
 	private:
 		std::unique_ptr<VertexArray> m_VAO;
 		std::unique_ptr<VertexBuffer> m_VertexBuffer;
-		std::unique_ptr<IndexBuffer> m_IndexBuffer;
+		std::shared_ptr<IndexBuffer> m_IndexBuffer;
 		std::unique_ptr<Shader> m_Shader;
+		UniformHandle m_ModelUniform;
+		UniformHandle m_ColorUniform;
 		std::unique_ptr<Texture> m_Texture;
 
 		glm::mat4 m_Proj;
@@ -0,0 +1,129 @@
+#include "TestCommandBuffers.h"
+
+#include "Renderer.h"
+#include "JobPool.h"
+
+#include "imgui/imgui.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace test {
+
+	static const int MaxWorkers = 8;
+
+	TestCommandBuffers::TestCommandBuffers()
+		: m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)),
+		m_View(glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0))),
+		m_ObjectCount(5000), m_WorkerCount(4), m_Time(0.0f),
+		m_RecordTimeMs(0.0f), m_ExecuteTimeMs(0.0f)
+	{
+		float positions[] = {  // unit quad around the origin
+			-0.5f, -0.5f,
+			 0.5f, -0.5f,
+			 0.5f,  0.5f,
+			-0.5f,  0.5f
+		};
+
+		m_VAO = std::make_unique<VertexArray>();
+		m_VertexBuffer = std::make_unique<VertexBuffer>(positions, sizeof(positions));
+		VertexBufferLayout layout;
+		layout.Push<float>(2);
+		m_VAO->AddBuffer(*m_VertexBuffer, layout);
+
+		m_IndexBuffer = IndexBuffer::GetQuadIndexBuffer(1);
+		m_Shader = std::make_unique<Shader>("res/shaders/BatchRendering.shader");
+		m_ModelUniform = m_Shader->GetUniformHandle("u_Model");
+		m_ColorUniform = m_Shader->GetUniformHandle("u_Color");
+
+		for (int i = 0; i < MaxWorkers; ++i)
+			m_CommandBuffers.push_back(std::make_unique<CommandBuffer>());
+	}
+
+	TestCommandBuffers::~TestCommandBuffers()
+	{
+	}
+
+	void TestCommandBuffers::OnUpdate(float deltaTime)
+	{
+		m_Time += deltaTime;
+	}
+
+	void TestCommandBuffers::RecordObjects(CommandBuffer& buffer, int first, int end) const
+	{
+		buffer.Reset();
+
+		// Every stream sets the state it needs, the replay drops what the previous stream already set
+		buffer.SetBlend(true, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		buffer.BindShader(*m_Shader);
+		buffer.BindVertexArray(*m_VAO);
+		buffer.BindIndexBuffer(*m_IndexBuffer);
+
+		// The CPU side of a draw: animate, cull and build the model matrix
+		for (int i = first; i < end; ++i)
+		{
+			const float t = m_Time * (0.2f + (i % 17) * 0.03f) + i * 0.61f;
+			const float radius = 30.0f + (i % 251) * 1.0f;
+			const glm::vec3 position(480.0f + cosf(t) * radius * 1.7f, 270.0f + sinf(t * 1.3f) * radius, 0.0f);
+			const float size = 4.0f + (i % 7) * 2.0f;
+
+			if (position.x + size < 0.0f || position.x - size > 960.0f || position.y + size < 0.0f || position.y - size > 540.0f)
+				continue;
+
+			glm::mat4 model = glm::translate(glm::mat4(1.0f), position);
+			model = glm::rotate(model, t * 2.0f, glm::vec3(0.0f, 0.0f, 1.0f));
+			model = glm::scale(model, glm::vec3(size, size, 1.0f));
+
+			buffer.SetUniformMat4f(m_ModelUniform, model);
+			buffer.SetUniform4f(m_ColorUniform, 0.5f + 0.5f * sinf(t), 0.5f + 0.5f * cosf(t * 0.7f), 0.8f, 0.9f);
+			buffer.DrawIndexed(6);
+		}
+	}
+
+	void TestCommandBuffers::OnRender()
+	{
+		GLStateCache::SetClearColor(0.05f, 0.05f, 0.08f, 1.0f);
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		Renderer::SetCamera(m_View, m_Proj);
+
+		// Contiguous ranges, one command buffer per job, recorded on the shared pool's threads
+		auto start = std::chrono::high_resolution_clock::now();
+		const int workers = m_WorkerCount < 1 ? 1 : m_WorkerCount;
+		const int chunk = (m_ObjectCount + workers - 1) / workers;
+		JobPool::Get().Run(workers, [&](unsigned int i)
+		{
+			const int first = std::min((int)i * chunk, m_ObjectCount);
+			RecordObjects(*m_CommandBuffers[i], first, std::min(first + chunk, m_ObjectCount));
+		});
+		m_RecordTimeMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+		// Fixed order: the image does not depend on which worker finished first
+		start = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < workers; ++i)
+			m_CommandBuffers[i]->Execute();
+		m_ExecuteTimeMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	void TestCommandBuffers::OnImGuiRender()
+	{
+		ImGui::SliderInt("Objects", &m_ObjectCount, 100, 100000);
+		ImGui::SliderInt("Recording jobs", &m_WorkerCount, 1, MaxWorkers);
+		ImGui::Text("Pool threads: %u + main", JobPool::Get().GetThreadCount());
+
+		unsigned int commands = 0, bytes = 0;
+		for (int i = 0; i < m_WorkerCount; ++i)
+		{
+			commands += m_CommandBuffers[i]->GetCommandCount();
+			bytes += m_CommandBuffers[i]->GetSize();
+		}
+		ImGui::Text("Commands: %u (%.1f KB)", commands, bytes / 1024.0f);
+		ImGui::Text("Record: %.3f ms, replay: %.3f ms", m_RecordTimeMs, m_ExecuteTimeMs);
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "Test.h"
+
+#include "CommandBuffer.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+
+	class TestCommandBuffers : public Test
+	{
+	public:
+		TestCommandBuffers();
+		~TestCommandBuffers();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		// Prepares objects [first, end) and records their draws into buffer
+		void RecordObjects(CommandBuffer& buffer, int first, int end) const;
+
+		std::unique_ptr<VertexArray> m_VAO;
+		std::unique_ptr<VertexBuffer> m_VertexBuffer;
+		std::shared_ptr<IndexBuffer> m_IndexBuffer;
+		std::unique_ptr<Shader> m_Shader;
+		UniformHandle m_ModelUniform;
+		UniformHandle m_ColorUniform;
+
+		std::vector<std::unique_ptr<CommandBuffer>> m_CommandBuffers;  // one per worker, replayed in this order
+
+		glm::mat4 m_Proj;
+		glm::mat4 m_View;
+
+		int m_ObjectCount;
+		int m_WorkerCount;
+		float m_Time;
+
+		float m_RecordTimeMs;
+		float m_ExecuteTimeMs;
+	};
+
+}
@@ -7,26 +7,21 @@
 #include "glm/glm.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 
-#include <array>
-
 namespace test {
 
 	TestDynamicBatchRendering::TestDynamicBatchRendering()
 		: m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)),
 		m_View(glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0))),
-		m_QuadPosition(0.0f, 0.0f)
+		m_QuadPosition(0.0f, 0.0f),
+		m_UpdateStrategy((int)BufferUpdateStrategy::SubData), m_FrameIndex(0),
+		m_DirtyTracking(false), m_MergeThreshold(256), m_LastUploadCount(0), m_LastUploadedBytes(0)
 	{
-		unsigned int indices[] = {  // You must use an unsigned type
-			0, 1, 2, 2, 3, 0,  // indices for one quad
-			4, 5, 6, 6, 7, 4
-		};
-
-		GLCall(glEnable(GL_BLEND));
-		GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+		GLStateCache::SetBlendEnabled(true);
+		GLStateCache::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 		m_VAO = std::make_unique<VertexArray>();
 
-		m_VertexBuffer = std::make_unique<VertexBuffer>(nullptr, sizeof(Vertex) * 1000);  // Create a buffer that can contain 1000 vertices
+		m_VertexBuffer = std::make_unique<VertexBuffer>(nullptr, sizeof(QuadVertex) * 1000);  // Create a buffer that can contain 1000 vertices
 		VertexBufferLayout layout;
 		layout.Push<float>(2);
 		layout.Push<float>(4);
@@ -34,9 +29,10 @@ namespace test {
 		layout.Push<float>(1);
 		m_VAO->AddBuffer(*m_VertexBuffer, layout);
 
-		m_IndexBuffer = std::make_unique<IndexBuffer>(indices, 12);
+		m_IndexBuffer = IndexBuffer::GetQuadIndexBuffer(2);  // shared 0, 1, 2, 2, 3, 0 pattern
 
 		m_Shader = std::make_unique<Shader>("res/shaders/Basic.shader");
+		m_ModelUniform = m_Shader->GetUniformHandle("u_Model");
 		m_Shader->Bind();
 		int samplers[2] = { 0, 1 };
 		m_Shader->SetUniform1iv("u_Textures", 2, samplers);
@@ -56,70 +52,78 @@ namespace test {
 
 	void TestDynamicBatchRendering::OnRender()
 	{
-		auto q0 = CreateQuad(m_QuadPosition[0], m_QuadPosition[1], 0.0f);
-		auto q1 = CreateQuad( 400.0f, 200.0f, 1.0f);
-
-		Vertex vertices[8];
-		memcpy(vertices, q0.data(), q0.size() * sizeof(Vertex));
-		memcpy(vertices + q0.size(), q1.data(), q1.size() * sizeof(Vertex));
-
-		// Set the dynamic vertex buffer
-		glBindBuffer(GL_ARRAY_BUFFER, m_VertexBuffer->GetID());
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);  // every frame dynamically populate the vertex buffer
+		// Two 200x200 quads, x and y are the bottom left corner
+		const float positionX[2] = { m_QuadPosition[0], 400.0f };
+		const float positionY[2] = { m_QuadPosition[1], 200.0f };
+		const float size[2] = { 200.0f, 200.0f };
+		const float color[2] = { 0.0f, 0.0f };  // Basic.shader adds the color to the texture
+		const float textureID[2] = { 0.0f, 1.0f };
+
+		QuadSpriteData sprites;
+		sprites.PositionX = positionX;
+		sprites.PositionY = positionY;
+		sprites.Width = size;
+		sprites.Height = size;
+		sprites.ColorR = sprites.ColorG = sprites.ColorB = sprites.ColorA = color;
+		sprites.TexIndex = textureID;
+
+		QuadVertex vertices[8];
+		GenerateQuadVertices(sprites, 0, 2, vertices);
+
+		unsigned int range = 0;
+		if (m_DirtyTracking)
+		{
+			// Always the same range: the shadow copy holds last frame's vertices and only the
+			// moved quad differs. Synchronized uploads, the GPU may still read these bytes.
+			m_VertexBuffer->SetMergeThreshold(m_MergeThreshold);
+			m_VertexBuffer->SetUpdateStrategy(BufferUpdateStrategy::SubData);
+			m_VertexBuffer->ResetUploadStats();
+			m_VertexBuffer->Write(0, vertices, sizeof(vertices));
+			m_VertexBuffer->FlushWrites();
+			m_LastUploadCount = m_VertexBuffer->GetUploadCount();
+			m_LastUploadedBytes = m_VertexBuffer->GetUploadedBytes();
+		}
+		else
+		{
+			// Every frame dynamically populate the vertex buffer. The write goes to one of 3 ranges in turn
+			// so that an unsynchronized map never touches the vertices the GPU may still be drawing.
+			range = m_FrameIndex++ % 3;
+			m_VertexBuffer->SetUpdateStrategy((BufferUpdateStrategy)m_UpdateStrategy);
+			m_VertexBuffer->Update(vertices, sizeof(vertices), range * sizeof(vertices));
+			m_LastUploadCount = 1;
+			m_LastUploadedBytes = sizeof(vertices);
+		}
 
-		GLCall(glClearColor(1.0f, 1.0f, 0.0f, 1.0f));
+		GLStateCache::SetClearColor(1.0f, 1.0f, 0.0f, 1.0f);
 		GLCall(glClear(GL_COLOR_BUFFER_BIT));
 
 		Renderer renderer;
+		Renderer::SetCamera(m_View, m_Proj);  // once, every draw below reads it
 
 		m_Texture1->Bind(1);
 		m_Texture2->Bind(0);
 
 		{
 			glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0));
-			glm::mat4 mvp = m_Proj * m_View * model;  // the order is important!
 			m_Shader->Bind();
-			m_Shader->SetUniformMat4f("u_MVP", mvp);
+			m_Shader->SetUniformMat4f(m_ModelUniform, model);
 
-			renderer.Draw(*m_VAO, *m_IndexBuffer, *m_Shader);
+			renderer.Draw(*m_VAO, *m_IndexBuffer, *m_Shader, 2 * 6, range * 8);  // 2 quads, 8 vertices per range
 		}
 	}
 
 	void TestDynamicBatchRendering::OnImGuiRender()
 	{
 		ImGui::SliderFloat2("Quad0 position", &m_QuadPosition.x, 0.0f, 960.0f);
+		// Update() bypasses the shadow copy, so it is reset each time tracking is turned on
+		if (ImGui::Checkbox("Dirty range tracking", &m_DirtyTracking) && m_DirtyTracking)
+			m_VertexBuffer->EnableShadowCopy(m_MergeThreshold);
+		if (m_DirtyTracking)
+			ImGui::SliderInt("Merge threshold (bytes)", &m_MergeThreshold, 0, 1024);
+		else
+			ImGui::Combo("Buffer update", &m_UpdateStrategy, "glBufferSubData\0Orphaning\0Unsynchronized map\0");
+		ImGui::Text("Uploaded: %u bytes in %u call(s)", m_LastUploadedBytes, m_LastUploadCount);
 		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
 	}
 
-	std::array<Vertex, 4> CreateQuad(float x, float y, float textureID)  // x and y are the bottom left corner of the quad
-	{
-		float size = 200.0f;
-
-		Vertex v0 = {
-			{x, y},
-			{0.0f, 0.0f, 0.0f, 0.0f},
-			{0.0f, 0.0f},
-			textureID };
-
-		Vertex v1 = {
-			{x + size, y},
-			{0.0f, 0.0f, 0.0f, 0.0f},
-			{1.0f, 0.0f},
-			textureID };
-
-		Vertex v2 = {
-			{x + size, y + size},
-			{0.0f, 0.0f, 0.0f, 0.0f},
-			{1.0f, 1.0f},
-			textureID };
-
-		Vertex v3 = {
-			{x,  y + size},
-			{0.0f, 0.0f, 0.0f, 0.0f},
-			{0.0f, 1.0f},
-			textureID };
-
-		return { v0, v1, v2, v3 };
-	}
-
 }
\ No newline at end of file
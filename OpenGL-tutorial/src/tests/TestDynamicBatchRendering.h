@@ -4,20 +4,12 @@
 #include "Texture.h"
 #include "VertexBuffer.h"
 #include "VertexBufferLayout.h"
+#include "QuadGenerator.h"
 
 #include <memory>
-#include <array>
 
 namespace test {
 
-	struct Vertex
-	{
-		float Position[2];
-		float Color[4];
-		float TexCoords[2];
-		float TexID;
-	};
-
 	class TestDynamicBatchRendering : public Test
 	{
 	public:
@@ -31,8 +23,9 @@ namespace test {
 	private:
 		std::unique_ptr<VertexArray> m_VAO;
 		std::unique_ptr<VertexBuffer> m_VertexBuffer;
-		std::unique_ptr<IndexBuffer> m_IndexBuffer;
+		std::shared_ptr<IndexBuffer> m_IndexBuffer;
 		std::unique_ptr<Shader> m_Shader;
+		UniformHandle m_ModelUniform;
 		std::unique_ptr<Texture> m_Texture1;
 		std::unique_ptr<Texture> m_Texture2;
 
@@ -40,8 +33,15 @@ namespace test {
 		glm::mat4 m_View;
 
 		glm::vec2 m_QuadPosition;
-	};
 
-	std::array<Vertex, 4> CreateQuad(float x, float y, float textureID);
+		int m_UpdateStrategy;  // BufferUpdateStrategy selected in the ImGui combo
+		unsigned int m_FrameIndex;
+
+		// Write through the shadow copy: only the bytes that changed since last frame are uploaded
+		bool m_DirtyTracking;
+		int m_MergeThreshold;
+		unsigned int m_LastUploadCount;
+		unsigned int m_LastUploadedBytes;
+	};
 
 }
\ No newline at end of file
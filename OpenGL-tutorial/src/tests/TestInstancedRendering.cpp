@@ -0,0 +1,207 @@
+#include "TestInstancedRendering.h"
+
+#include "Renderer.h"
+
+#include "imgui/imgui.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <cstdlib>
+
+namespace test {
+
+	static const float WorldWidth = 4 * 960.0f;
+
+	static void AddSpriteBuffers(VertexArray& va, const VertexBuffer& quad, const VertexBuffer& instances)
+	{
+		VertexBufferLayout quadLayout;
+		quadLayout.Push<float>(2);
+		va.AddBuffer(quad, quadLayout);
+
+		VertexBufferLayout instanceLayout(1);  // advance once per instance
+		instanceLayout.Push<float>(2);
+		instanceLayout.Push<float>(2);
+		instanceLayout.Push<float>(1);
+		instanceLayout.Push<float>(4);
+		instanceLayout.Push<unsigned char>(4);
+		va.AddBuffer(instances, instanceLayout);
+	}
+
+	TestInstancedRendering::TestInstancedRendering()
+		: m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)),
+		m_View(glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0))),
+		m_InstanceCount(10000), m_BufferCapacity(0), m_UploadEveryFrame(false),
+		m_DrawCount(1), m_MultiDraw(true), m_CommandsInstanceCount(0), m_CommandsDrawCount(0),
+		m_GPUCulling(false), m_CameraX(0.0f)
+	{
+		float quad[] = {  // unit quad shared by every instance
+			0.0f, 0.0f,
+			1.0f, 0.0f,
+			1.0f, 1.0f,
+			0.0f, 1.0f
+		};
+
+		GLStateCache::SetBlendEnabled(true);
+		GLStateCache::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+		m_QuadVertexBuffer = std::make_unique<VertexBuffer>(quad, sizeof(quad));
+		m_IndexBuffer = IndexBuffer::GetQuadIndexBuffer(1);
+
+		m_Shader = std::make_unique<Shader>("res/shaders/Instanced.shader");
+		m_Shader->Bind();
+		m_Shader->SetUniform1i("u_Texture", 0);
+
+		m_Texture = std::make_unique<Texture>("res/textures/logo.png");
+
+		m_DrawCommands = std::make_unique<DrawIndirectBuffer>();
+
+		// The culled command only exists on the GPU, the one-draw-per-command fallback of
+		// MultiDrawIndirect would replay the CPU copy with no instances
+		if (Renderer::GetCapabilities().ComputeShaders && Renderer::GetCapabilities().MultiDrawIndirect)
+		{
+			m_Culler = std::make_unique<InstanceCuller>("res/shaders/CullSprites.shader");
+			m_CullCommands = std::make_unique<DrawIndirectBuffer>(1);
+		}
+
+		BuildInstances();
+	}
+
+	TestInstancedRendering::~TestInstancedRendering()
+	{
+	}
+
+	void TestInstancedRendering::BuildInstances()
+	{
+		m_Instances.resize(m_InstanceCount);
+		for (SpriteInstance& instance : m_Instances)
+		{
+			const float size = 4.0f + (rand() % 28);
+			instance.Position[0] = (float)(rand() % (int)WorldWidth);
+			instance.Position[1] = (float)(rand() % 540);
+			instance.Size[0] = size;
+			instance.Size[1] = size;
+			instance.Rotation = (rand() % 628) / 100.0f;
+			instance.UVRect[0] = 0.0f;
+			instance.UVRect[1] = 0.0f;
+			instance.UVRect[2] = 1.0f;
+			instance.UVRect[3] = 1.0f;
+			instance.Color[0] = (unsigned char)(rand() % 256);
+			instance.Color[1] = (unsigned char)(rand() % 256);
+			instance.Color[2] = (unsigned char)(rand() % 256);
+			instance.Color[3] = 255;
+		}
+
+		const unsigned int size = m_InstanceCount * sizeof(SpriteInstance);
+		if ((unsigned int)m_InstanceCount > m_BufferCapacity)
+		{
+			// The attribute bindings point at the buffer, so a bigger buffer needs a new vertex array
+			m_InstanceBuffer = std::make_unique<VertexBuffer>(m_Instances.data(), size);
+			m_VAO = std::make_unique<VertexArray>();
+			AddSpriteBuffers(*m_VAO, *m_QuadVertexBuffer, *m_InstanceBuffer);
+
+			if (m_Culler)
+			{
+				m_VisibleBuffer = std::make_unique<VertexBuffer>(nullptr, size);
+				m_CulledVAO = std::make_unique<VertexArray>();
+				AddSpriteBuffers(*m_CulledVAO, *m_QuadVertexBuffer, *m_VisibleBuffer);
+			}
+
+			m_BufferCapacity = m_InstanceCount;
+		}
+		else
+		{
+			m_InstanceBuffer->Update(m_Instances.data(), size);
+		}
+	}
+
+	void TestInstancedRendering::BuildDrawCommands()
+	{
+		if (m_CommandsInstanceCount == m_InstanceCount && m_CommandsDrawCount == m_DrawCount)
+			return;
+
+		// Same quad for every command, each one draws its own range of instances
+		m_DrawCommands->Clear();
+		const unsigned int perDraw = (m_InstanceCount + m_DrawCount - 1) / m_DrawCount;
+		for (unsigned int first = 0; first < (unsigned int)m_InstanceCount; first += perDraw)
+		{
+			DrawElementsIndirectCommand command;
+			command.Count = 6;
+			command.InstanceCount = (first + perDraw <= (unsigned int)m_InstanceCount) ? perDraw : m_InstanceCount - first;
+			command.FirstIndex = 0;
+			command.BaseVertex = 0;
+			command.BaseInstance = first;
+			m_DrawCommands->Add(command);
+		}
+		m_DrawCommands->Upload();
+
+		m_CommandsInstanceCount = m_InstanceCount;
+		m_CommandsDrawCount = m_DrawCount;
+	}
+
+	void TestInstancedRendering::OnUpdate(float deltaTime)
+	{
+	}
+
+	void TestInstancedRendering::OnRender()
+	{
+		GLStateCache::SetClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		if ((unsigned int)m_InstanceCount != m_Instances.size())
+			BuildInstances();
+		else if (m_UploadEveryFrame)
+			m_InstanceBuffer->Update(m_Instances.data(), m_InstanceCount * sizeof(SpriteInstance));
+
+		Renderer renderer;
+
+		m_Texture->Bind();
+		m_View = glm::translate(glm::mat4(1.0f), glm::vec3(-m_CameraX, 0, 0));
+
+		{
+			glm::mat4 mvp = m_Proj * m_View;
+
+			if (m_GPUCulling && m_Culler)
+				m_Culler->Cull(*m_InstanceBuffer, m_InstanceCount, *m_VisibleBuffer, *m_CullCommands, 6, mvp);
+
+			Renderer::SetCamera(m_View, m_Proj);
+			m_Shader->Bind();
+
+			if (m_GPUCulling && m_Culler)
+			{
+				// The instance count was written by the compute shader
+				renderer.MultiDrawIndirect(*m_CulledVAO, *m_IndexBuffer, *m_Shader, *m_CullCommands);
+			}
+			else if (m_DrawCount == 1)
+			{
+				renderer.DrawInstanced(*m_VAO, *m_IndexBuffer, *m_Shader, 6, m_InstanceCount);
+			}
+			else
+			{
+				BuildDrawCommands();
+				if (m_MultiDraw)
+					renderer.MultiDrawIndirect(*m_VAO, *m_IndexBuffer, *m_Shader, *m_DrawCommands);
+				else
+					renderer.DrawCommands(*m_VAO, *m_IndexBuffer, *m_Shader, *m_DrawCommands);
+			}
+		}
+	}
+
+	void TestInstancedRendering::OnImGuiRender()
+	{
+		ImGui::SliderInt("Instances", &m_InstanceCount, 1, 1000000);
+		ImGui::SliderFloat("Camera x", &m_CameraX, 0.0f, WorldWidth - 960.0f);
+		if (m_Culler)
+			ImGui::Checkbox("GPU culling (compute)", &m_GPUCulling);
+		else
+			ImGui::Text("GPU culling needs GL 4.3 compute shaders and multi-draw indirect");
+		ImGui::Checkbox("Upload every frame", &m_UploadEveryFrame);
+		ImGui::SliderInt("Draws", &m_DrawCount, 1, 1000);
+		ImGui::Checkbox("Multi-draw indirect", &m_MultiDraw);
+		if (!Renderer::GetCapabilities().MultiDrawIndirect)
+			ImGui::Text("glMultiDrawElementsIndirect not supported, using one draw per command");
+		ImGui::Text("Instance data: %.2f MB", m_InstanceCount * sizeof(SpriteInstance) / (1024.0f * 1024.0f));
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "Test.h"
+
+#include "Texture.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "DrawIndirectBuffer.h"
+#include "InstanceCuller.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+
+	// 40 bytes per sprite instead of 4 expanded vertices (144 bytes)
+	struct SpriteInstance
+	{
+		float Position[2];
+		float Size[2];
+		float Rotation;
+		float UVRect[4];
+		unsigned char Color[4];
+	};
+
+	class TestInstancedRendering : public Test
+	{
+	public:
+		TestInstancedRendering();
+		~TestInstancedRendering();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		void BuildInstances();
+		void BuildDrawCommands();
+
+		std::unique_ptr<VertexArray> m_VAO;
+		std::unique_ptr<VertexBuffer> m_QuadVertexBuffer;
+		std::unique_ptr<VertexBuffer> m_InstanceBuffer;
+		std::shared_ptr<IndexBuffer> m_IndexBuffer;
+		std::unique_ptr<Shader> m_Shader;
+		std::unique_ptr<Texture> m_Texture;
+		std::unique_ptr<DrawIndirectBuffer> m_DrawCommands;
+
+		// GPU culling: the compute shader copies the visible instances of m_InstanceBuffer
+		// to m_VisibleBuffer, drawn through m_CulledVAO with the count it wrote in m_CullCommands
+		std::unique_ptr<InstanceCuller> m_Culler;
+		std::unique_ptr<VertexBuffer> m_VisibleBuffer;
+		std::unique_ptr<VertexArray> m_CulledVAO;
+		std::unique_ptr<DrawIndirectBuffer> m_CullCommands;
+
+		glm::mat4 m_Proj;
+		glm::mat4 m_View;
+
+		std::vector<SpriteInstance> m_Instances;
+		int m_InstanceCount;
+		unsigned int m_BufferCapacity;  // instances the current instance buffer can hold
+		bool m_UploadEveryFrame;
+
+		// The instances are split into m_DrawCount ranges, one indirect command each
+		int m_DrawCount;
+		bool m_MultiDraw;  // one glMultiDrawElementsIndirect instead of m_DrawCount draw calls
+		int m_CommandsInstanceCount;
+		int m_CommandsDrawCount;
+
+		bool m_GPUCulling;
+		float m_CameraX;  // the sprites cover 4 screens horizontally
+	};
+
+}
@@ -0,0 +1,161 @@
+#include "TestMeshOptimizer.h"
+
+#include "Renderer.h"
+#include "QuadGenerator.h"
+
+#include "imgui/imgui.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace test {
+
+	TestMeshOptimizer::TestMeshOptimizer()
+		: m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)),
+		m_View(glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0))),
+		m_GridSize(256), m_BuiltGridSize(0), m_Optimized(true), m_DrawCount(20),
+		m_TimerPending(false), m_GpuTimeMs(0.0f)
+	{
+		m_Shader = std::make_unique<Shader>("res/shaders/LitMesh.shader");
+		m_ModelUniform = m_Shader->GetUniformHandle("u_Model");
+		m_ColorUniform = m_Shader->GetUniformHandle("u_Color");
+		GLCall(glGenQueries(1, &m_TimerQuery));
+	}
+
+	TestMeshOptimizer::~TestMeshOptimizer()
+	{
+		GLCall(glDeleteQueries(1, &m_TimerQuery));
+	}
+
+	void TestMeshOptimizer::BuildMeshes()
+	{
+		if (m_BuiltGridSize == m_GridSize)
+			return;
+
+		// The grid is flat on screen but shaded as the surface h = sin(x) cos(y), whose normal
+		// is stored in one 32-bit word instead of three floats
+		const int n = m_GridSize;
+		std::vector<MeshVertex> vertices;
+		vertices.reserve(n * n);
+		for (int y = 0; y < n; ++y)
+		{
+			for (int x = 0; x < n; ++x)
+			{
+				const float u = x * 12.0f / (n - 1), v = y * 12.0f / (n - 1);
+				const glm::vec3 normal = glm::normalize(glm::vec3(-cosf(u) * cosf(v), sinf(u) * sinf(v), 1.0f));
+
+				MeshVertex vertex;
+				vertex.Position[0] = 20.0f + x * 500.0f / (n - 1);
+				vertex.Position[1] = 20.0f + y * 500.0f / (n - 1);
+				vertex.Normal = PackSnorm1010102(normal.x, normal.y, normal.z, 0.0f);
+				vertices.push_back(vertex);
+			}
+		}
+
+		// Shuffled triangles stand in for a mesh exported without any care for the cache
+		std::vector<unsigned int> triangles;
+		for (int y = 0; y < n - 1; ++y)
+		{
+			for (int x = 0; x < n - 1; ++x)
+			{
+				unsigned int a = y * n + x, b = a + 1, c = a + n + 1, d = a + n;
+				triangles.insert(triangles.end(), { a, b, c, c, d, a });
+			}
+		}
+		std::vector<unsigned int> order(triangles.size() / 3);
+		for (unsigned int i = 0; i < order.size(); ++i)
+			order[i] = i;
+		std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+		std::vector<unsigned int> indices;
+		indices.reserve(triangles.size());
+		for (unsigned int t : order)
+			indices.insert(indices.end(), { triangles[t * 3], triangles[t * 3 + 1], triangles[t * 3 + 2] });
+
+		std::vector<MeshVertex> optimizedVertices = vertices;
+		std::vector<unsigned int> optimizedIndices = indices;
+		m_Stats = OptimizeMesh(optimizedVertices.data(), n * n, sizeof(MeshVertex), optimizedIndices.data(), (unsigned int)optimizedIndices.size());
+
+		const std::vector<MeshVertex>* vertexData[2] = { &vertices, &optimizedVertices };
+		const std::vector<unsigned int>* indexData[2] = { &indices, &optimizedIndices };
+		for (int i = 0; i < 2; ++i)
+		{
+			m_VAO[i] = std::make_unique<VertexArray>();
+			m_VertexBuffer[i] = std::make_unique<VertexBuffer>(vertexData[i]->data(), (unsigned int)(vertexData[i]->size() * sizeof(MeshVertex)));
+			VertexBufferLayout layout;
+			layout.Push<float>(2);
+			layout.PushPacked(true, true);
+			ASSERT(layout.GetStride() == sizeof(MeshVertex));
+			m_VAO[i]->AddBuffer(*m_VertexBuffer[i], layout);
+			m_IndexBuffer[i] = std::make_unique<IndexBuffer>(indexData[i]->data(), (unsigned int)indexData[i]->size());
+		}
+
+		m_BuiltGridSize = m_GridSize;
+	}
+
+	void TestMeshOptimizer::OnUpdate(float deltaTime)
+	{
+	}
+
+	void TestMeshOptimizer::OnRender()
+	{
+		GLStateCache::SetClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		BuildMeshes();
+
+		if (m_TimerPending)
+		{
+			int available = 0;
+			GLCall(glGetQueryObjectiv(m_TimerQuery, GL_QUERY_RESULT_AVAILABLE, &available));
+			if (available)
+			{
+				GLuint64 elapsed = 0;
+				GLCall(glGetQueryObjectui64v(m_TimerQuery, GL_QUERY_RESULT, &elapsed));
+				m_GpuTimeMs = elapsed / 1000000.0f;
+				m_TimerPending = false;
+			}
+		}
+
+		const int mesh = m_Optimized ? 1 : 0;
+		glm::mat4 model(1.0f);
+		Renderer::SetCamera(m_View, m_Proj);
+		m_Shader->Bind();
+		m_Shader->SetUniformMat4f(m_ModelUniform, model);
+		m_Shader->SetUniform4f(m_ColorUniform, 0.2f, 0.6f, 0.9f, 1.0f);
+
+		const bool startTimer = !m_TimerPending;
+		if (startTimer)
+		{
+			GLCall(glBeginQuery(GL_TIME_ELAPSED, m_TimerQuery));
+		}
+
+		Renderer renderer;
+		for (int i = 0; i < m_DrawCount; ++i)
+			renderer.Draw(*m_VAO[mesh], *m_IndexBuffer[mesh], *m_Shader);
+
+		if (startTimer)
+		{
+			GLCall(glEndQuery(GL_TIME_ELAPSED));
+			m_TimerPending = true;
+		}
+	}
+
+	void TestMeshOptimizer::OnImGuiRender()
+	{
+		ImGui::SliderInt("Grid size", &m_GridSize, 2, 512);
+		ImGui::Checkbox("Optimized order", &m_Optimized);
+		ImGui::SliderInt("Draws per frame", &m_DrawCount, 1, 100);
+
+		ImGui::Text("Triangles: %u", (m_BuiltGridSize - 1) * (m_BuiltGridSize - 1) * 2);
+		ImGui::Text("ACMR (16 entry FIFO): %.3f before, %.3f after", m_Stats.ACMRBefore, m_Stats.ACMRAfter);
+		ImGui::Text("GPU time: %.3f ms", m_GpuTimeMs);
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+
+}
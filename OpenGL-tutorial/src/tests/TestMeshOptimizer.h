@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Test.h"
+
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "MeshOptimizer.h"
+
+#include <memory>
+
+namespace test {
+
+	class TestMeshOptimizer : public Test
+	{
+	public:
+		TestMeshOptimizer();
+		~TestMeshOptimizer();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		struct MeshVertex
+		{
+			float Position[2];
+			unsigned int Normal;  // PackSnorm1010102
+		};
+
+		void BuildMeshes();
+
+		// Same grid twice: triangles in random order, and the same list after OptimizeMesh
+		std::unique_ptr<VertexArray> m_VAO[2];
+		std::unique_ptr<VertexBuffer> m_VertexBuffer[2];
+		std::unique_ptr<IndexBuffer> m_IndexBuffer[2];
+		std::unique_ptr<Shader> m_Shader;
+		UniformHandle m_ModelUniform;
+		UniformHandle m_ColorUniform;
+
+		glm::mat4 m_Proj;
+		glm::mat4 m_View;
+
+		int m_GridSize;  // vertices per side
+		int m_BuiltGridSize;
+		bool m_Optimized;
+		int m_DrawCount;  // the mesh is drawn several times so the vertex work shows in the GPU time
+		MeshOptimizationStats m_Stats;
+
+		// GPU time of the draws, read a frame later so the query never stalls
+		unsigned int m_TimerQuery;
+		bool m_TimerPending;
+		float m_GpuTimeMs;
+	};
+
+}
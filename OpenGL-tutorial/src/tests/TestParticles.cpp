@@ -0,0 +1,94 @@
+#include "TestParticles.h"
+
+#include "Renderer.h"
+
+#include "imgui/imgui.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace test {
+
+	TestParticles::TestParticles()
+		: m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)),
+		m_EmitPerSecond(100000), m_EmitRemainder(0.0f), m_WorkerCount(1), m_Paused(false),
+		m_UpdateTimeMs(0.0f), m_RenderTimeMs(0.0f)
+	{
+		GLStateCache::SetBlendEnabled(true);
+		GLStateCache::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+		// Packed vertices: a million quads a frame is mostly vertex bandwidth
+		m_Renderer2D = std::make_unique<Renderer2D>(50000, Renderer2D::VertexFormat::Packed);
+		m_Particles = std::make_unique<ParticleSystem>(1000000);
+
+		m_Props.Position = glm::vec2(480.0f, 100.0f);
+		m_Props.Velocity = glm::vec2(0.0f, 300.0f);
+		m_Props.VelocityVariation = glm::vec2(150.0f, 100.0f);
+		m_Props.ColorBegin = glm::vec4(1.0f, 0.8f, 0.2f, 1.0f);
+		m_Props.ColorEnd = glm::vec4(0.8f, 0.1f, 0.1f, 0.0f);
+		m_Props.SizeBegin = 6.0f;
+		m_Props.SizeEnd = 1.0f;
+		m_Props.LifeTime = 4.0f;
+	}
+
+	TestParticles::~TestParticles()
+	{
+	}
+
+	void TestParticles::OnUpdate(float deltaTime)
+	{
+		if (m_Paused)
+			return;
+
+		// Long frames (a breakpoint, a window drag) would fire a huge burst
+		if (deltaTime > 0.1f)
+			deltaTime = 0.1f;
+
+		float emit = m_EmitPerSecond * deltaTime + m_EmitRemainder;
+		m_EmitRemainder = emit - (unsigned int)emit;
+		m_Particles->Emit(m_Props, (unsigned int)emit);
+
+		auto start = std::chrono::high_resolution_clock::now();
+		m_Particles->SetWorkerCount(m_WorkerCount);
+		m_Particles->Update(deltaTime);
+		m_UpdateTimeMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	void TestParticles::OnRender()
+	{
+		GLStateCache::SetClearColor(0.05f, 0.05f, 0.08f, 1.0f);
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		auto start = std::chrono::high_resolution_clock::now();
+		m_Renderer2D->ResetStats();
+		m_Renderer2D->BeginScene(m_Proj);
+		m_Particles->Render(*m_Renderer2D);
+		m_Renderer2D->EndScene();
+		m_RenderTimeMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	void TestParticles::OnImGuiRender()
+	{
+		ImGui::SliderInt("Emit per second", &m_EmitPerSecond, 0, 1000000);
+		ImGui::SliderFloat("Life time", &m_Props.LifeTime, 0.1f, 10.0f);
+		ImGui::SliderFloat2("Velocity", &m_Props.Velocity.x, -500.0f, 500.0f);
+		ImGui::SliderFloat2("Variation", &m_Props.VelocityVariation.x, 0.0f, 500.0f);
+		ImGui::ColorEdit4("Color begin", &m_Props.ColorBegin.x);
+		ImGui::ColorEdit4("Color end", &m_Props.ColorEnd.x);
+		const unsigned int cores = std::thread::hardware_concurrency();
+		ImGui::SliderInt("Update threads", &m_WorkerCount, 1, cores > 1 ? (int)cores : 1);
+		ImGui::Checkbox("Paused", &m_Paused);
+		if (ImGui::Button("Clear"))
+			m_Particles->Clear();
+
+		const auto& stats = m_Renderer2D->GetStats();
+		ImGui::Text("Particles: %u / %u", m_Particles->GetCount(), m_Particles->GetMaxParticles());
+		ImGui::Text("Update: %.2f ms, batching: %.2f ms", m_UpdateTimeMs, m_RenderTimeMs);
+		ImGui::Text("Draw calls: %u", stats.DrawCalls);
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "Test.h"
+
+#include "Renderer2D.h"
+#include "ParticleSystem.h"
+
+#include <memory>
+
+namespace test {
+
+	class TestParticles : public Test
+	{
+	public:
+		TestParticles();
+		~TestParticles();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		std::unique_ptr<Renderer2D> m_Renderer2D;
+		std::unique_ptr<ParticleSystem> m_Particles;
+
+		glm::mat4 m_Proj;
+
+		ParticleProps m_Props;
+		int m_EmitPerSecond;
+		float m_EmitRemainder;  // fraction of a particle carried over to the next frame
+		int m_WorkerCount;
+		bool m_Paused;
+
+		float m_UpdateTimeMs;
+		float m_RenderTimeMs;
+	};
+
+}
@@ -0,0 +1,125 @@
+#include "TestRenderQueue.h"
+
+#include "Renderer.h"
+
+#include "imgui/imgui.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+namespace test {
+
+	TestRenderQueue::TestRenderQueue()
+		: m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)),
+		m_View(glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0))),
+		m_Sorting(true)
+	{
+		float texturedPositions[] = {  // x y texX texY
+			-20.0f, -20.0f, 0.0f, 0.0f,
+			 20.0f, -20.0f, 1.0f, 0.0f,
+			 20.0f,  20.0f, 1.0f, 1.0f,
+			-20.0f,  20.0f, 0.0f, 1.0f
+		};
+
+		float coloredPositions[] = {  // x y r g b alpha texX texY texIndex
+			-20.0f, -20.0f, 0.3f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+			 20.0f, -20.0f, 0.3f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+			 20.0f,  20.0f, 0.3f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f,
+			-20.0f,  20.0f, 0.3f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f
+		};
+
+		GLStateCache::SetBlendEnabled(true);
+		GLStateCache::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+		m_TexturedVAO = std::make_unique<VertexArray>();
+		m_TexturedVertexBuffer = std::make_unique<VertexBuffer>(texturedPositions, sizeof(texturedPositions));
+		VertexBufferLayout texturedLayout;
+		texturedLayout.Push<float>(2);
+		texturedLayout.Push<float>(2);
+		m_TexturedVAO->AddBuffer(*m_TexturedVertexBuffer, texturedLayout);
+
+		m_ColoredVAO = std::make_unique<VertexArray>();
+		m_ColoredVertexBuffer = std::make_unique<VertexBuffer>(coloredPositions, sizeof(coloredPositions));
+		VertexBufferLayout coloredLayout;
+		coloredLayout.Push<float>(2);
+		coloredLayout.Push<float>(4);
+		coloredLayout.Push<float>(2);
+		coloredLayout.Push<float>(1);
+		m_ColoredVAO->AddBuffer(*m_ColoredVertexBuffer, coloredLayout);
+
+		m_IndexBuffer = IndexBuffer::GetQuadIndexBuffer(1);
+
+		m_TextureShader = std::make_unique<Shader>("res/shaders/Texture.shader");
+		m_TextureShader->Bind();
+		m_TextureShader->SetUniform1i("u_Texture", 0);
+
+		m_BasicShader = std::make_unique<Shader>("res/shaders/Basic.shader");
+		m_BasicShader->Bind();
+		int samplers[2] = { 0, 1 };
+		m_BasicShader->SetUniform1iv("u_Textures", 2, samplers);
+
+		m_Texture1 = std::make_unique<Texture>("res/textures/logo.png");
+		m_Texture2 = std::make_unique<Texture>("res/textures/fire.png");
+
+		m_RenderQueue = std::make_unique<RenderQueue>();
+
+		// A grid of objects whose program, vertex array and texture change from one to the next
+		for (int y = 0; y < 12; ++y)
+		{
+			for (int x = 0; x < 22; ++x)
+			{
+				const int i = y * 22 + x;
+
+				RenderCommand command;
+				command.IB = m_IndexBuffer.get();
+				command.IndexCount = 6;
+				command.Transform = glm::translate(glm::mat4(1.0f), glm::vec3(40.0f + x * 42.0f, 40.0f + y * 42.0f, 0.0f));
+				command.Textures[0] = (i % 3) ? m_Texture1.get() : m_Texture2.get();
+				if (i % 2)
+				{
+					command.VAO = m_TexturedVAO.get();
+					command.Program = m_TextureShader.get();
+				}
+				else
+				{
+					command.VAO = m_ColoredVAO.get();
+					command.Program = m_BasicShader.get();
+				}
+				m_Objects.push_back(command);
+			}
+		}
+	}
+
+	TestRenderQueue::~TestRenderQueue()
+	{
+	}
+
+	void TestRenderQueue::OnUpdate(float deltaTime)
+	{
+	}
+
+	void TestRenderQueue::OnRender()
+	{
+		GLStateCache::SetClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		m_RenderQueue->SetSortingEnabled(m_Sorting);
+		m_RenderQueue->Begin(m_View, m_Proj);
+		for (const RenderCommand& command : m_Objects)
+			m_RenderQueue->Submit(command);
+		m_RenderQueue->End();
+	}
+
+	void TestRenderQueue::OnImGuiRender()
+	{
+		ImGui::Checkbox("Sort by state", &m_Sorting);
+
+		const auto& stats = m_RenderQueue->GetStats();
+		ImGui::Text("Draw calls: %u", stats.DrawCalls);
+		ImGui::Text("Shader changes: %u", stats.ShaderChanges);
+		ImGui::Text("Vertex array changes: %u", stats.VertexArrayChanges);
+		ImGui::Text("Texture changes: %u", stats.TextureChanges);
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+
+}
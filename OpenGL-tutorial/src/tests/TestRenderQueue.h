@@ -0,0 +1,44 @@
+#pragma once
+#include "Test.h"
+
+#include "Texture.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "RenderQueue.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+
+	class TestRenderQueue : public Test
+	{
+	public:
+		TestRenderQueue();
+		~TestRenderQueue();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		std::unique_ptr<VertexArray> m_TexturedVAO;
+		std::unique_ptr<VertexBuffer> m_TexturedVertexBuffer;
+		std::unique_ptr<VertexArray> m_ColoredVAO;
+		std::unique_ptr<VertexBuffer> m_ColoredVertexBuffer;
+		std::shared_ptr<IndexBuffer> m_IndexBuffer;
+		std::unique_ptr<Shader> m_TextureShader;
+		std::unique_ptr<Shader> m_BasicShader;
+		std::unique_ptr<Texture> m_Texture1;
+		std::unique_ptr<Texture> m_Texture2;
+
+		std::unique_ptr<RenderQueue> m_RenderQueue;
+		std::vector<RenderCommand> m_Objects;  // submitted in this (interleaved) order every frame
+
+		glm::mat4 m_Proj;
+		glm::mat4 m_View;
+
+		bool m_Sorting;
+	};
+
+}
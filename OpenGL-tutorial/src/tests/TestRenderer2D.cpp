@@ -0,0 +1,174 @@
+#include "TestRenderer2D.h"
+
+#include "Renderer.h"
+
+#include "imgui/imgui.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+namespace test {
+
+	TestRenderer2D::TestRenderer2D()
+		: m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)),
+		m_View(glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0))),
+		m_GridSize(100), m_Textured(false), m_Bulk(false),
+		m_Culling(true), m_PackedVertices(false), m_Retained(false), m_Zoom(1.0f),
+		m_SpritesGridSize(0), m_StaticGridSize(0), m_StaticGridTextured(false)
+	{
+		GLStateCache::SetBlendEnabled(true);
+		GLStateCache::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+		m_Renderer2D = std::make_unique<Renderer2D>();
+		m_Texture = std::make_unique<Texture>("res/textures/logo.png");
+		m_Texture2 = std::make_unique<Texture>("res/textures/fire.png");
+	}
+
+	TestRenderer2D::~TestRenderer2D()
+	{
+	}
+
+	void TestRenderer2D::OnUpdate(float deltaTime)
+	{
+	}
+
+	void TestRenderer2D::OnRender()
+	{
+		GLStateCache::SetClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		m_Proj = glm::ortho(0.0f, 960.0f / m_Zoom, 0.0f, 540.0f / m_Zoom, -1.0f, 1.0f);
+
+		m_Renderer2D->ResetStats();
+		m_Renderer2D->SetCullingEnabled(m_Culling);
+		m_Renderer2D->BeginScene(m_Proj * m_View);
+
+		if (m_Retained)
+		{
+			BuildStaticGrid();
+			m_Renderer2D->DrawStaticBatch(*m_StaticGrid);
+		}
+		else if (m_Bulk)
+		{
+			BuildSprites();
+
+			QuadSpriteData sprites;
+			sprites.PositionX = m_PositionX.data();
+			sprites.PositionY = m_PositionY.data();
+			sprites.Width = m_Width.data();
+			sprites.Height = m_Height.data();
+			sprites.ColorR = m_ColorR.data();
+			sprites.ColorG = m_ColorG.data();
+			sprites.ColorB = m_ColorB.data();
+			m_Renderer2D->DrawQuads(sprites, (unsigned int)m_PositionX.size(), m_Textured ? m_Texture.get() : nullptr);
+		}
+		else
+		{
+			const glm::vec2 cell(960.0f / m_GridSize, 540.0f / m_GridSize);
+			const glm::vec2 size = cell * 0.9f;
+			for (int y = 0; y < m_GridSize; ++y)
+			{
+				for (int x = 0; x < m_GridSize; ++x)
+				{
+					glm::vec2 position(x * cell.x, y * cell.y);
+					glm::vec4 color((float)x / m_GridSize, 0.4f, (float)y / m_GridSize, 1.0f);
+					if (m_Textured)
+						m_Renderer2D->DrawQuad(position, size, (x + y) % 2 ? *m_Texture2 : *m_Texture, color);
+					else
+						m_Renderer2D->DrawQuad(position, size, color);
+				}
+			}
+		}
+
+		m_Renderer2D->EndScene();
+	}
+
+	void TestRenderer2D::BuildSprites()
+	{
+		if (m_SpritesGridSize == m_GridSize)
+			return;
+
+		const unsigned int count = m_GridSize * m_GridSize;
+		for (auto* array : { &m_PositionX, &m_PositionY, &m_Width, &m_Height, &m_ColorR, &m_ColorG, &m_ColorB })
+			array->resize(count);
+
+		const glm::vec2 cell(960.0f / m_GridSize, 540.0f / m_GridSize);
+		for (int y = 0; y < m_GridSize; ++y)
+		{
+			for (int x = 0; x < m_GridSize; ++x)
+			{
+				const unsigned int i = y * m_GridSize + x;
+				m_PositionX[i] = x * cell.x;
+				m_PositionY[i] = y * cell.y;
+				m_Width[i] = cell.x * 0.9f;
+				m_Height[i] = cell.y * 0.9f;
+				m_ColorR[i] = (float)x / m_GridSize;
+				m_ColorG[i] = 0.4f;
+				m_ColorB[i] = (float)y / m_GridSize;
+			}
+		}
+
+		m_SpritesGridSize = m_GridSize;
+	}
+
+	void TestRenderer2D::BuildStaticGrid()
+	{
+		if (m_StaticGrid && m_StaticGrid->GetVertexFormat() != m_Renderer2D->GetVertexFormat())
+			m_StaticGrid = nullptr;
+		if (!m_StaticGrid)
+		{
+			m_StaticGrid = std::make_unique<StaticBatch>(m_Renderer2D->GetVertexFormat());
+			m_StaticGridSize = 0;
+		}
+
+		// Same grid as the immediate path; left alone while the settings don't change, so the batch keeps its generation
+		if (m_StaticGridSize == m_GridSize && m_StaticGridTextured == m_Textured)
+			return;
+
+		m_StaticGrid->Clear();
+		const glm::vec2 cell(960.0f / m_GridSize, 540.0f / m_GridSize);
+		const glm::vec2 size = cell * 0.9f;
+		for (int y = 0; y < m_GridSize; ++y)
+		{
+			for (int x = 0; x < m_GridSize; ++x)
+			{
+				glm::vec2 position(x * cell.x, y * cell.y);
+				glm::vec4 color((float)x / m_GridSize, 0.4f, (float)y / m_GridSize, 1.0f);
+				if (m_Textured)
+					m_StaticGrid->AddQuad(position, size, (x + y) % 2 ? *m_Texture2 : *m_Texture, color);
+				else
+					m_StaticGrid->AddQuad(position, size, color);
+			}
+		}
+
+		m_StaticGridSize = m_GridSize;
+		m_StaticGridTextured = m_Textured;
+	}
+
+	void TestRenderer2D::OnImGuiRender()
+	{
+		ImGui::SliderInt("Grid size", &m_GridSize, 1, 300);
+		ImGui::Checkbox("Textured", &m_Textured);
+		ImGui::Checkbox("Bulk submission (SoA)", &m_Bulk);
+		ImGui::Checkbox("Retained grid (static batch)", &m_Retained);
+		ImGui::Checkbox("View culling", &m_Culling);
+		if (ImGui::Checkbox("Packed vertices", &m_PackedVertices))
+		{
+			m_Renderer2D = std::make_unique<Renderer2D>(10000,
+				m_PackedVertices ? Renderer2D::VertexFormat::Packed : Renderer2D::VertexFormat::Float);
+		}
+		ImGui::SliderFloat("Zoom", &m_Zoom, 1.0f, 20.0f);
+
+		const auto& stats = m_Renderer2D->GetStats();
+		ImGui::Text("Quads: %u (%u culled, %s)", stats.QuadCount, stats.CulledQuads, IsQuadCullingAVX() ? "AVX" : "SSE");
+		ImGui::Text("Draw calls: %u", stats.DrawCalls);
+		if (m_Retained)
+			ImGui::Text("Static quads: %u (%u rebuilds in total)", stats.StaticQuads, m_StaticGrid ? m_StaticGrid->GetBuildCount() : 0);
+		ImGui::Text("Vertex size: %u bytes (%u KB per frame)", m_Renderer2D->GetVertexSize(),
+			stats.QuadCount * 4 * m_Renderer2D->GetVertexSize() / 1024);
+		ImGui::Text("Texture binds: %u (%u slots)", stats.TextureBinds, m_Renderer2D->GetMaxTextureSlots());
+		ImGui::Text("Vertex buffer stalls: %u", stats.BufferStalls);
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include "Test.h"
+
+#include "Texture.h"
+#include "Renderer2D.h"
+#include "StaticBatch.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+
+	class TestRenderer2D : public Test
+	{
+	public:
+		TestRenderer2D();
+		~TestRenderer2D();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		void BuildSprites();
+		void BuildStaticGrid();
+
+		std::unique_ptr<Renderer2D> m_Renderer2D;
+		std::unique_ptr<Texture> m_Texture;
+		std::unique_ptr<Texture> m_Texture2;
+
+		glm::mat4 m_Proj;
+		glm::mat4 m_View;
+
+		int m_GridSize;  // the scene draws m_GridSize * m_GridSize quads
+		bool m_Textured;
+		bool m_Bulk;  // submit the grid with DrawQuads instead of one DrawQuad per sprite
+		bool m_Culling;
+		bool m_PackedVertices;  // 20-byte vertices instead of 36-byte ones, recreates the renderer
+		bool m_Retained;  // the grid lives in a StaticBatch and is only regenerated when it changes
+		float m_Zoom;  // zooming in on the bottom left corner pushes most of the grid out of view
+
+		// Structure-of-arrays copy of the grid for the bulk path
+		int m_SpritesGridSize;
+		std::vector<float> m_PositionX, m_PositionY, m_Width, m_Height;
+		std::vector<float> m_ColorR, m_ColorG, m_ColorB;
+
+		std::unique_ptr<StaticBatch> m_StaticGrid;
+		int m_StaticGridSize;
+		bool m_StaticGridTextured;
+	};
+
+}
@@ -0,0 +1,85 @@
+#include "TestShapes.h"
+
+#include "Renderer.h"
+
+#include "imgui/imgui.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <cmath>
+
+namespace test {
+
+	// Vertices the same gauge takes when every curve is tessellated with 64 segments
+	// (panel corners 4 x 16, two rings as strips, the hub as a fan, the needle as a strip with round caps)
+	static const unsigned int TessellatedGaugeVertices = (4 * 17) + 2 * (65 * 2) + 65 + (2 * 33);
+
+	TestShapes::TestShapes()
+		: m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)),
+		m_GaugesPerRow(8), m_Time(0.0f), m_Zoom(1.0f)
+	{
+		GLStateCache::SetBlendEnabled(true);
+		GLStateCache::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+		m_Renderer2D = std::make_unique<Renderer2D>();
+	}
+
+	TestShapes::~TestShapes()
+	{
+	}
+
+	void TestShapes::OnUpdate(float deltaTime)
+	{
+		m_Time += deltaTime;
+	}
+
+	void TestShapes::OnRender()
+	{
+		GLStateCache::SetClearColor(0.08f, 0.08f, 0.1f, 1.0f);
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		// Zoom on the center, the edges must stay sharp
+		const glm::vec2 viewSize(960.0f / m_Zoom, 540.0f / m_Zoom);
+		const glm::vec2 viewMin = glm::vec2(480.0f, 270.0f) - viewSize * 0.5f;
+		m_Proj = glm::ortho(viewMin.x, viewMin.x + viewSize.x, viewMin.y, viewMin.y + viewSize.y, -1.0f, 1.0f);
+
+		m_Renderer2D->ResetStats();
+		m_Renderer2D->BeginScene(m_Proj);
+
+		const float cell = 540.0f / m_GaugesPerRow;
+		const float radius = cell * 0.35f;
+		for (int y = 0; y < m_GaugesPerRow; ++y)
+		{
+			for (int x = 0; x < m_GaugesPerRow; ++x)
+			{
+				const glm::vec2 center(210.0f + (x + 0.5f) * cell, (y + 0.5f) * cell);
+				const float value = 0.5f + 0.5f * sinf(m_Time * 1.3f + x * 0.7f + y * 1.1f);
+				const float angle = glm::radians(225.0f - value * 270.0f);
+				const glm::vec2 tip = center + glm::vec2(cosf(angle), sinf(angle)) * radius * 0.85f;
+
+				m_Renderer2D->DrawRoundedRect(center - glm::vec2(cell * 0.46f), glm::vec2(cell * 0.92f), cell * 0.1f, glm::vec4(0.18f, 0.19f, 0.23f, 1.0f));
+				m_Renderer2D->DrawRing(center, radius, radius * 0.12f, glm::vec4(0.35f, 0.37f, 0.42f, 1.0f));
+				m_Renderer2D->DrawRing(center, radius * 0.75f, radius * 0.03f, glm::vec4(value, 1.0f - value, 0.2f, 1.0f));
+				m_Renderer2D->DrawCapsule(center, tip, radius * 0.05f, glm::vec4(0.95f, 0.4f, 0.2f, 1.0f));
+				m_Renderer2D->DrawCircle(center, radius * 0.1f, glm::vec4(0.9f, 0.9f, 0.9f, 1.0f));
+			}
+		}
+
+		m_Renderer2D->EndScene();
+	}
+
+	void TestShapes::OnImGuiRender()
+	{
+		ImGui::SliderInt("Gauges per row", &m_GaugesPerRow, 1, 60);
+		ImGui::SliderFloat("Zoom", &m_Zoom, 1.0f, 20.0f);
+
+		const auto& stats = m_Renderer2D->GetStats();
+		const unsigned int gauges = m_GaugesPerRow * m_GaugesPerRow;
+		ImGui::Text("Shapes: %u (%u culled)", stats.ShapeCount, stats.CulledQuads);
+		ImGui::Text("Vertices: %u, tessellated: %u", stats.ShapeCount * 4, gauges * TessellatedGaugeVertices);
+		ImGui::Text("Draw calls: %u", stats.DrawCalls);
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+
+}
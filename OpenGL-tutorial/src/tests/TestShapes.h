@@ -0,0 +1,30 @@
+#pragma once
+#include "Test.h"
+
+#include "Renderer2D.h"
+
+#include <memory>
+
+namespace test {
+
+	class TestShapes : public Test
+	{
+	public:
+		TestShapes();
+		~TestShapes();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		std::unique_ptr<Renderer2D> m_Renderer2D;
+
+		glm::mat4 m_Proj;
+
+		int m_GaugesPerRow;  // dashboard of m_GaugesPerRow^2 gauges
+		float m_Time;
+		float m_Zoom;
+	};
+
+}
@@ -0,0 +1,79 @@
+#include "TestText.h"
+
+#include "Renderer.h"
+
+#include "imgui/imgui.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <random>
+
+namespace test {
+
+	// Any TrueType file will do, this one ships with Windows
+	static const char* FontPath = "C:/Windows/Fonts/arial.ttf";
+
+	TestText::TestText()
+		: m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f)),
+		m_UseSDF(true), m_TitleSize(64.0f), m_LabelCount(1000)
+	{
+		GLStateCache::SetBlendEnabled(true);
+		GLStateCache::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+		m_Renderer2D = std::make_unique<Renderer2D>();
+		m_BitmapFont = std::make_unique<Font>(FontPath, 16.0f);
+		m_SDFFont = std::make_unique<Font>(FontPath, 32.0f, true);
+
+		std::mt19937 random(7);
+		std::uniform_real_distribution<float> x(0.0f, 900.0f), y(0.0f, 440.0f);
+		for (int i = 0; i < 10000; ++i)
+		{
+			m_Labels.push_back("Unit " + std::to_string(i) + " HP " + std::to_string(random() % 100));
+			m_LabelPositions.push_back(glm::vec2(x(random), y(random)));
+		}
+	}
+
+	TestText::~TestText()
+	{
+	}
+
+	void TestText::OnUpdate(float deltaTime)
+	{
+	}
+
+	void TestText::OnRender()
+	{
+		GLStateCache::SetClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		const Font& font = m_UseSDF ? *m_SDFFont : *m_BitmapFont;
+
+		m_Renderer2D->ResetStats();
+		m_Renderer2D->BeginScene(m_Proj);
+
+		for (int i = 0; i < m_LabelCount; ++i)
+			m_Renderer2D->DrawString(m_Labels[i], m_LabelPositions[i], 12.0f, font, glm::vec4(0.6f, 0.9f, 0.6f, 1.0f));
+
+		m_Renderer2D->DrawQuad(glm::vec2(20.0f, 440.0f), glm::vec2(920.0f, 90.0f), glm::vec4(0.0f, 0.0f, 0.0f, 0.7f));
+		m_Renderer2D->DrawString("Kerning: AVA Wave To\xC3\xA9", glm::vec2(30.0f, 460.0f), m_TitleSize, font);
+
+		m_Renderer2D->EndScene();
+	}
+
+	void TestText::OnImGuiRender()
+	{
+		if (!m_SDFFont->IsLoaded())
+			ImGui::Text("Font %s not found", FontPath);
+
+		ImGui::Checkbox("Signed distance field glyphs", &m_UseSDF);
+		ImGui::SliderFloat("Title size", &m_TitleSize, 8.0f, 256.0f);
+		ImGui::SliderInt("Labels", &m_LabelCount, 0, (int)m_Labels.size());
+
+		const auto& stats = m_Renderer2D->GetStats();
+		ImGui::Text("Glyph quads: %u", stats.QuadCount);
+		ImGui::Text("Draw calls: %u", stats.DrawCalls);
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "Test.h"
+
+#include "Font.h"
+#include "Renderer2D.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace test {
+
+	class TestText : public Test
+	{
+	public:
+		TestText();
+		~TestText();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		std::unique_ptr<Renderer2D> m_Renderer2D;
+		std::unique_ptr<Font> m_BitmapFont;  // baked at the size it is usually drawn at
+		std::unique_ptr<Font> m_SDFFont;
+
+		glm::mat4 m_Proj;
+
+		bool m_UseSDF;
+		float m_TitleSize;
+		int m_LabelCount;  // small HUD-like labels scattered over the screen
+		std::vector<std::string> m_Labels;
+		std::vector<glm::vec2> m_LabelPositions;
+	};
+
+}
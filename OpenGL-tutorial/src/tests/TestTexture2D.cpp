@@ -27,8 +27,8 @@ namespace test {
 			2, 3, 0,  // indices for the left triangle
 		};
 
-		GLCall(glEnable(GL_BLEND));
-		GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+		GLStateCache::SetBlendEnabled(true);
+		GLStateCache::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 		m_VAO = std::make_unique<VertexArray>();
 
@@ -41,6 +41,7 @@ namespace test {
 		m_IndexBuffer = std::make_unique<IndexBuffer>(indices, 6);
 		
 		m_Shader = std::make_unique<Shader>("res/shaders/Texture.shader");
+		m_ModelUniform = m_Shader->GetUniformHandle("u_Model");
 		m_Shader->Bind();
 
 		m_Texture = std::make_unique<Texture>("res/textures/logo.png");
@@ -58,27 +59,26 @@ namespace test {
 
 	void TestTexture2D::OnRender()
 	{
-		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLStateCache::SetClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 		GLCall(glClear(GL_COLOR_BUFFER_BIT));
 
 		Renderer renderer;
+		Renderer::SetCamera(m_View, m_Proj);  // once, every draw below reads it
 
 		m_Texture->Bind();
 
 		{
 			glm::mat4 model = glm::translate(glm::mat4(1.0f), m_TranslationA);
-			glm::mat4 mvp = m_Proj * m_View * model;  // the order is important!
 			m_Shader->Bind();
-			m_Shader->SetUniformMat4f("u_MVP", mvp);
+			m_Shader->SetUniformMat4f(m_ModelUniform, model);
 
 			renderer.Draw(*m_VAO, *m_IndexBuffer, *m_Shader);
 		}
 
 		{
 			glm::mat4 model = glm::translate(glm::mat4(1.0f), m_TranslationB);
-			glm::mat4 mvp = m_Proj * m_View * model;  // the order is important!
 			m_Shader->Bind();
-			m_Shader->SetUniformMat4f("u_MVP", mvp);
+			m_Shader->SetUniformMat4f(m_ModelUniform, model);
 
 			renderer.Draw(*m_VAO, *m_IndexBuffer, *m_Shader);
 		}
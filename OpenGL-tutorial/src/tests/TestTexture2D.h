@@ -25,6 +25,7 @@ namespace test {
 		std::unique_ptr<VertexBuffer> m_VertexBuffer;
 		std::unique_ptr<IndexBuffer> m_IndexBuffer;
 		std::unique_ptr<Shader> m_Shader;
+		UniformHandle m_ModelUniform;
 		std::unique_ptr<Texture> m_Texture;
 
 		glm::vec3 m_TranslationA;
@@ -0,0 +1,124 @@
+#include "TestTilemap.h"
+
+#include "Renderer.h"
+
+#include "imgui/imgui.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <cstdlib>
+#include <vector>
+
+namespace test {
+
+	static const unsigned int MapSize = 4096;
+	static const float TileSize = 16.0f;
+	static const int TilesetCells = 4;     // 4x4 cells
+	static const int TilesetCellPixels = 16;
+
+	// Flat colored cells with a darker border, so that the tile edges are visible
+	static std::vector<unsigned char> GenerateTileset()
+	{
+		const int size = TilesetCells * TilesetCellPixels;
+		std::vector<unsigned char> pixels(size * size * 4);
+		for (int y = 0; y < size; ++y)
+		{
+			for (int x = 0; x < size; ++x)
+			{
+				// Texture rows go from the bottom, cells are numbered from the top
+				const int cell = (TilesetCells - 1 - y / TilesetCellPixels) * TilesetCells + x / TilesetCellPixels;
+				const int cx = x % TilesetCellPixels, cy = y % TilesetCellPixels;
+				const bool border = cx == 0 || cy == 0 || cx == TilesetCellPixels - 1 || cy == TilesetCellPixels - 1;
+				const float shade = border ? 0.6f : 1.0f;
+
+				unsigned char* p = &pixels[(y * size + x) * 4];
+				p[0] = (unsigned char)(shade * (64 + (cell * 53) % 192));
+				p[1] = (unsigned char)(shade * (64 + (cell * 97) % 192));
+				p[2] = (unsigned char)(shade * (64 + (cell * 31) % 192));
+				p[3] = 255;
+			}
+		}
+		return pixels;
+	}
+
+	TestTilemap::TestTilemap()
+		: m_Proj(1.0f), m_CameraPosition{ 480.0f, 270.0f }, m_Zoom(1.0f), m_Culling(true), m_EditCount(0)
+	{
+		GLStateCache::SetBlendEnabled(true);
+		GLStateCache::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+		m_Renderer2D = std::make_unique<Renderer2D>();
+
+		const std::vector<unsigned char> pixels = GenerateTileset();
+		const int size = TilesetCells * TilesetCellPixels;
+		m_Tileset = std::make_unique<Texture>(size, size, pixels.data());
+
+		// Some empty tiles, the rest in bands that change slowly across the map
+		m_Tilemap = std::make_unique<Tilemap>(MapSize, MapSize, TileSize, *m_Tileset, TilesetCells, TilesetCells);
+		srand(1234);
+		for (unsigned int y = 0; y < MapSize; ++y)
+		{
+			for (unsigned int x = 0; x < MapSize; ++x)
+			{
+				const int r = rand();
+				if (r % 8 == 0)
+					continue;
+				const unsigned int band = ((x / 48) + (y / 32)) % (TilesetCells * TilesetCells - 2);
+				m_Tilemap->SetTile(x, y, (unsigned short)(1 + band + (r % 16 == 1 ? 1 : 0)));
+			}
+		}
+	}
+
+	TestTilemap::~TestTilemap()
+	{
+	}
+
+	void TestTilemap::OnUpdate(float deltaTime)
+	{
+	}
+
+	void TestTilemap::OnRender()
+	{
+		GLStateCache::SetClearColor(0.05f, 0.05f, 0.05f, 1.0f);
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+		const glm::vec2 viewSize(960.0f / m_Zoom, 540.0f / m_Zoom);
+		const glm::vec2 viewMin = glm::vec2(m_CameraPosition[0], m_CameraPosition[1]) - viewSize * 0.5f;
+		m_Proj = glm::ortho(viewMin.x, viewMin.x + viewSize.x, viewMin.y, viewMin.y + viewSize.y, -1.0f, 1.0f);
+
+		m_Renderer2D->SetCullingEnabled(m_Culling);
+		m_Renderer2D->ResetStats();
+		m_Renderer2D->BeginScene(m_Proj);
+		m_Renderer2D->DrawTilemap(*m_Tilemap);
+		m_Renderer2D->EndScene();
+	}
+
+	void TestTilemap::OnImGuiRender()
+	{
+		const float mapExtent = MapSize * TileSize;
+		ImGui::SliderFloat2("Camera", m_CameraPosition, 0.0f, mapExtent);
+		ImGui::SliderFloat("Zoom", &m_Zoom, 0.05f, 4.0f);
+		ImGui::Checkbox("Chunk culling", &m_Culling);
+
+		// Paint the tile at the center of the screen, only its chunk is rebuilt
+		if (ImGui::Button("Edit center tile"))
+		{
+			const int x = (int)(m_CameraPosition[0] / TileSize), y = (int)(m_CameraPosition[1] / TileSize);
+			if (x >= 0 && y >= 0 && x < (int)MapSize && y < (int)MapSize)
+			{
+				m_Tilemap->SetTile(x, y, (unsigned short)(1 + m_EditCount % (TilesetCells * TilesetCells)));
+				m_EditCount++;
+			}
+		}
+
+		const auto& stats = m_Renderer2D->GetStats();
+		ImGui::Text("Map: %ux%u tiles, %ux%u chunks", MapSize, MapSize, m_Tilemap->GetChunkCountX(), m_Tilemap->GetChunkCountY());
+		ImGui::Text("Chunks drawn: %u, resident: %u", stats.TilemapChunks, m_Tilemap->GetResidentChunkCount());
+		ImGui::Text("Chunk builds: %u", m_Tilemap->GetChunkBuildCount());
+		ImGui::Text("Tiles drawn: %u", stats.StaticQuads);
+		ImGui::Text("Draw calls: %u", stats.DrawCalls);
+		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+	}
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include "Test.h"
+
+#include "Renderer2D.h"
+#include "Texture.h"
+#include "Tilemap.h"
+
+#include <memory>
+
+namespace test {
+
+	class TestTilemap : public Test
+	{
+	public:
+		TestTilemap();
+		~TestTilemap();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+	private:
+		std::unique_ptr<Renderer2D> m_Renderer2D;
+		std::unique_ptr<Texture> m_Tileset;
+		std::unique_ptr<Tilemap> m_Tilemap;
+
+		glm::mat4 m_Proj;
+
+		float m_CameraPosition[2];  // world position at the center of the screen
+		float m_Zoom;
+		bool m_Culling;
+		unsigned int m_EditCount;
+	};
+
+}